@@ -0,0 +1,65 @@
+#ifndef APPLIB_BENCH_DATA_HPP
+#define APPLIB_BENCH_DATA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace bench {
+
+constexpr std::size_t dataSize = std::size_t{1} << 20;
+
+using AllBits = std::integer_sequence<std::uint16_t,
+    8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+    21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32>;
+
+using BytesBits = std::integer_sequence<std::uint16_t, 8, 16, 24, 32>;
+
+//----------------------------------------------------------------------------//
+inline const std::vector<std::byte>& getData() {
+    static const auto ret = [] {
+        auto gen = std::mt19937(42);
+        auto distr = std::uniform_int_distribution<unsigned>(0, 255);
+        auto data = std::vector<std::byte>(dataSize);
+        for (auto& b: data) {
+            b = std::byte(distr(gen));
+        }
+        return data;
+    }();
+    return ret;
+}
+
+//----------------------------------------------------------------------------//
+inline void setRates(benchmark::State& state, std::size_t bytesCount,
+                     std::size_t wordsCount) {
+    const auto iterations = static_cast<std::int64_t>(state.iterations());
+    state.SetBytesProcessed(iterations * bytesCount);
+    state.counters["words"] = benchmark::Counter(
+        static_cast<double>(iterations * wordsCount),
+        benchmark::Counter::kIsRate);
+}
+
+//----------------------------------------------------------------------------//
+/**
+ * @brief registerForBits - register benchmark instantiation for each width.
+ * @param name - benchmark name prefix.
+ * @param fn - benchmark function template instantiator, called with
+ * std::integral_constant of bits count.
+ */
+template <std::uint16_t... numBits>
+void registerForBits(const char* name, auto fn,
+                     std::integer_sequence<std::uint16_t, numBits...>) {
+    (benchmark::RegisterBenchmark(
+         (std::string(name) + "/" + std::to_string(numBits)).c_str(),
+         fn(std::integral_constant<std::uint16_t, numBits>{})), ...);
+}
+
+}  // namespace bench
+
+#endif  // APPLIB_BENCH_DATA_HPP
@@ -0,0 +1,33 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include <applib/flow/bits_word_flow.hpp>
+
+#include "bench_data.hpp"
+
+namespace {
+
+//----------------------------------------------------------------------------//
+template <std::uint16_t numBits>
+void bitsWordFlowIterate(benchmark::State& state) {
+    const auto& data = bench::getData();
+    const auto flow = BitsWordFlow<numBits>(data);
+    for (auto _: state) {
+        std::uint64_t sum = 0;
+        for (auto word: flow) {
+            sum += BitsWord<numBits>::ord(word);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    bench::setRates(state, data.size(), flow.size());
+}
+
+const bool registered = (bench::registerForBits(
+    "BitsWordFlow",
+    []<std::uint16_t numBits>(std::integral_constant<std::uint16_t, numBits>) {
+        return &bitsWordFlowIterate<numBits>;
+    },
+    bench::AllBits{}), true);
+
+}  // namespace
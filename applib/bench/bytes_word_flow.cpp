@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include <applib/flow/bytes_word_flow.hpp>
+
+#include "bench_data.hpp"
+
+namespace {
+
+//----------------------------------------------------------------------------//
+template <std::uint16_t numBits>
+void bytesWordFlowIterate(benchmark::State& state) {
+    constexpr auto numBytes = static_cast<std::uint8_t>(numBits / 8);
+    const auto& data = bench::getData();
+    const auto flow = BytesWordFlow<numBytes>(data);
+    for (auto _: state) {
+        std::uint64_t sum = 0;
+        for (auto word: flow) {
+            sum += BytesWord<numBytes>::ord(word);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    bench::setRates(state, data.size(), flow.size());
+}
+
+const bool registered = (bench::registerForBits(
+    "BytesWordFlow",
+    []<std::uint16_t numBits>(std::integral_constant<std::uint16_t, numBits>) {
+        return &bytesWordFlowIterate<numBits>;
+    },
+    bench::BytesBits{}), true);
+
+}  // namespace
@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+#include <ael/dictionary/adaptive_a_dictionary.hpp>
+#include <ael/dictionary/adaptive_d_dictionary.hpp>
+#include <ael/dictionary/adaptive_dictionary.hpp>
+
+#include <applib/fenwick_dictionary.hpp>
+#include <applib/ord_and_tail_splitter.hpp>
+
+#include "bench_data.hpp"
+
+namespace {
+
+//----------------------------------------------------------------------------//
+std::vector<std::uint64_t> getOrds(std::uint16_t numBits) {
+    auto ret = std::vector<std::uint64_t>();
+    std::visit([&](const auto& ords) {
+        ret.assign(ords.begin(), ords.end());
+    }, OrdAndTailSplitter::process(bench::getData(), numBits).ords);
+    return ret;
+}
+
+//----------------------------------------------------------------------------//
+void dictionaryEncode(benchmark::State& state, auto makeDict) {
+    const auto numBits = static_cast<std::uint16_t>(state.range(0));
+    const auto ords = getOrds(numBits);
+    for (auto _: state) {
+        auto dict = makeDict(std::uint64_t{1} << numBits);
+        for (const auto ord: ords) {
+            benchmark::DoNotOptimize(dict.getProbabilityStats(ord));
+        }
+    }
+    bench::setRates(state, bench::getData().size(), ords.size());
+}
+
+//----------------------------------------------------------------------------//
+void dictionaryDecode(benchmark::State& state, auto makeDict) {
+    const auto numBits = static_cast<std::uint16_t>(state.range(0));
+    const auto ords = getOrds(numBits);
+    // Cumulative counts the decoder finds in the coded data.
+    auto cumulatives = std::vector<std::uint64_t>();
+    auto coderDict = makeDict(std::uint64_t{1} << numBits);
+    for (const auto ord: ords) {
+        cumulatives.push_back(coderDict.getProbabilityStats(ord).low);
+    }
+    for (auto _: state) {
+        auto dict = makeDict(std::uint64_t{1} << numBits);
+        for (const auto cumulative: cumulatives) {
+            const auto ord = dict.getWordOrd(cumulative);
+            benchmark::DoNotOptimize(dict.getProbabilityStats(ord));
+        }
+    }
+    bench::setRates(state, bench::getData().size(), ords.size());
+}
+
+//----------------------------------------------------------------------------//
+const auto makeSegmentTree = [](std::uint64_t wordsCount) {
+    return ael::dict::AdaptiveDictionary(wordsCount, 2);
+};
+
+const auto makeFenwick = [](std::uint64_t wordsCount) {
+    return FenwickDictionary(wordsCount, 2);
+};
+
+const auto makeSegmentTreeA = [](std::uint64_t wordsCount) {
+    return ael::dict::AdaptiveADictionary(wordsCount);
+};
+
+const auto makeFenwickA = [](std::uint64_t wordsCount) {
+    return FenwickADictionary(wordsCount);
+};
+
+const auto makeSegmentTreeD = [](std::uint64_t wordsCount) {
+    return ael::dict::AdaptiveDDictionary(wordsCount);
+};
+
+const auto makeFenwickD = [](std::uint64_t wordsCount) {
+    return FenwickDDictionary(wordsCount);
+};
+
+BENCHMARK_CAPTURE(dictionaryEncode, segment_tree, makeSegmentTree)
+    ->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_CAPTURE(dictionaryEncode, fenwick, makeFenwick)
+    ->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_CAPTURE(dictionaryDecode, segment_tree, makeSegmentTree)
+    ->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_CAPTURE(dictionaryDecode, fenwick, makeFenwick)
+    ->Arg(8)->Arg(12)->Arg(16);
+
+BENCHMARK_CAPTURE(dictionaryEncode, segment_tree_a, makeSegmentTreeA)
+    ->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_CAPTURE(dictionaryEncode, fenwick_a, makeFenwickA)
+    ->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_CAPTURE(dictionaryDecode, segment_tree_a, makeSegmentTreeA)
+    ->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_CAPTURE(dictionaryDecode, fenwick_a, makeFenwickA)
+    ->Arg(8)->Arg(12)->Arg(16);
+
+BENCHMARK_CAPTURE(dictionaryEncode, segment_tree_d, makeSegmentTreeD)
+    ->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_CAPTURE(dictionaryEncode, fenwick_d, makeFenwickD)
+    ->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_CAPTURE(dictionaryDecode, segment_tree_d, makeSegmentTreeD)
+    ->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_CAPTURE(dictionaryDecode, fenwick_d, makeFenwickD)
+    ->Arg(8)->Arg(12)->Arg(16);
+
+}  // namespace
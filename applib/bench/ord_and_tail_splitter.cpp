@@ -0,0 +1,25 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <variant>
+
+#include <applib/ord_and_tail_splitter.hpp>
+
+#include "bench_data.hpp"
+
+namespace {
+
+//----------------------------------------------------------------------------//
+void ordAndTailSplitterProcess(benchmark::State& state) {
+    const auto numBits = static_cast<std::uint8_t>(state.range(0));
+    const auto& data = bench::getData();
+    for (auto _: state) {
+        auto ret = OrdAndTailSplitter::process(data, numBits);
+        benchmark::DoNotOptimize(ret);
+    }
+    bench::setRates(state, data.size(), data.size() * 8 / numBits);
+}
+
+BENCHMARK(ordAndTailSplitterProcess)->DenseRange(8, 32);
+
+}  // namespace
@@ -0,0 +1,36 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+#include <applib/bits_writer.hpp>
+#include <applib/ord_and_tail_splitter.hpp>
+#include <applib/word_packer.hpp>
+
+#include "bench_data.hpp"
+
+namespace {
+
+//----------------------------------------------------------------------------//
+void wordPackerProcess(benchmark::State& state) {
+    const auto numBits = static_cast<std::uint8_t>(state.range(0));
+    const auto& data = bench::getData();
+    const auto ords = OrdAndTailSplitter::process(data, numBits).ords;
+    auto out = std::vector<std::byte>(data.size());
+    std::size_t wordsCount = 0;
+    for (auto _: state) {
+        std::visit([&](const auto& ords) {
+            auto writer = BitsWriter(out);
+            WordPacker::process(ords, writer, numBits);
+            benchmark::DoNotOptimize(writer.finish());
+            wordsCount = ords.size();
+        }, ords);
+        benchmark::ClobberMemory();
+    }
+    bench::setRates(state, data.size(), wordsCount);
+}
+
+BENCHMARK(wordPackerProcess)->DenseRange(8, 32);
+
+}  // namespace
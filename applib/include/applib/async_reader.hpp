@@ -0,0 +1,116 @@
+#ifndef APPLIB_ASYNC_READER_HPP
+#define APPLIB_ASYNC_READER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The AsyncReader class. Reads a file by chunks ahead of the reader:
+/// while one chunk is processed, reads of the next ones are in flight.
+/// Regular files are read with io_uring where it is available, other files
+/// (pipes, standard input) and other systems use a helper thread.
+///
+/// Chunks are read to page aligned buffers, which go back to the reader when
+/// chunks are destroyed, so reading a file takes as many buffers as chunks
+/// are held at once plus the ones in flight.
+///
+class AsyncReader {
+private:
+
+    class _Pool;
+
+    struct _AlignedDelete {
+        void operator()(std::byte* data) const;
+    };
+
+    using _Storage = std::unique_ptr<std::byte[], _AlignedDelete>;
+
+public:
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The Chunk class. Read data, owns its buffer until destruction.
+    ///
+    class Chunk {
+    public:
+        Chunk() = default;
+
+        Chunk(Chunk&&) noexcept = default;
+
+        Chunk& operator=(Chunk&& other) noexcept;
+
+        ~Chunk();
+
+        /**
+         * @brief getData - get read data.
+         * @return data span, valid while the chunk exists.
+         */
+        std::span<const std::byte> getData() const {
+            return {_storage.get(), _size};
+        }
+
+    private:
+        Chunk(std::shared_ptr<_Pool> pool, _Storage storage, std::size_t size)
+            : _pool(std::move(pool)), _storage(std::move(storage)),
+              _size(size) {}
+
+        void _release();
+
+        friend class AsyncReader;
+
+    private:
+        std::shared_ptr<_Pool> _pool;
+        _Storage _storage;
+        std::size_t _size{0};
+    };
+
+    constexpr static std::size_t defaultDepth = 2;
+    constexpr static std::size_t bufferAlignment = 4096;
+
+public:
+
+    /**
+     * @brief AsyncReader - reader constructor. Starts reading.
+     * @param fileName - file name, "-" for standard input.
+     * @param chunkSize - size of chunks.
+     * @param depth - number of chunks read ahead.
+     */
+    AsyncReader(const std::string& fileName,
+                std::size_t chunkSize,
+                std::size_t depth = defaultDepth);
+
+    AsyncReader(AsyncReader&&) noexcept;
+
+    AsyncReader& operator=(AsyncReader&&) noexcept;
+
+    /**
+     * Waits for reads in flight.
+     */
+    ~AsyncReader();
+
+    /**
+     * @brief next - take next chunk. Waits if it is not read yet.
+     * @return chunk, smaller than chunk size only at the end of file and
+     * empty after it.
+     */
+    Chunk next();
+
+    /**
+     * @brief isIoUring - check if reads go through io_uring.
+     * @return true for io_uring, false for helper thread.
+     */
+    bool isIoUring() const;
+
+private:
+
+    class _Impl;
+    class _UringImpl;
+    class _ThreadImpl;
+
+private:
+    std::unique_ptr<_Impl> _impl;
+};
+
+#endif  // APPLIB_ASYNC_READER_HPP
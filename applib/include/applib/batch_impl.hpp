@@ -0,0 +1,92 @@
+#ifndef APPLIB_BATCH_IMPL_HPP
+#define APPLIB_BATCH_IMPL_HPP
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+#include "stats.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The BatchImpl class. Runs one encoder or decoder over many files in
+/// one process. Input files are given as positional arguments or by
+/// --input-file (globs are expanded), and by a manifest file with one name
+/// per line.
+///
+/// Files are taken by workers from one queue, the biggest first, so a worker
+/// takes the next file as soon as it is free and no one waits for a wave of
+/// files to finish.
+///
+/// "-" stands for standard input and output. Output of standard input is
+/// standard output if it is not set.
+///
+struct BatchImpl {
+    struct Options {
+        std::vector<std::string> inFileNames;
+        std::string manifestFileName;
+        std::string outFileName;
+        std::string outDirName;
+        std::size_t jobsCount;
+        std::string statsParam;
+        bool perfCounters;
+    };
+
+    struct Job {
+        std::string inFileName;
+        std::string outFileName;
+    };
+
+    using ProcessFile =
+        std::function<void(const Job&, std::ostream&, Stats&)>;
+
+    /**
+     * @brief addOptions - add input and output files options.
+     * @param descr - options description to add to.
+     * @param options - options to fill.
+     */
+    static void addOptions(boost::program_options::options_description& descr,
+                           Options& options);
+
+    /**
+     * @brief store - parse command line with input files as positional
+     * arguments.
+     * @param argc - arguments count.
+     * @param argv - arguments.
+     * @param descr - options description.
+     * @param vm - variables map to store to.
+     */
+    static void store(int argc, char* argv[],
+                      const boost::program_options::options_description& descr,
+                      boost::program_options::variables_map& vm);
+
+    /**
+     * @brief makeJobs - get input and output files names.
+     * @param options - batch options.
+     * @param outSuffix - suffix of output file name if it is not set.
+     * @return jobs, the biggest input file first.
+     */
+    static std::vector<Job> makeJobs(const Options& options,
+                                     const std::string& outSuffix);
+
+    /**
+     * @brief run - process all files. If there are many files, each one is
+     * processed with logs turned off and a line is logged when it is done.
+     * Errors of one file do not stop others. Stats of each file are written
+     * if --stats is set.
+     * @param jobs - files to process.
+     * @param options - batch options.
+     * @param logStream - log stream.
+     * @param processFile - function to process one file.
+     */
+    static void run(const std::vector<Job>& jobs,
+                    const Options& options,
+                    std::ostream& logStream,
+                    const ProcessFile& processFile);
+};
+
+#endif  // APPLIB_BATCH_IMPL_HPP
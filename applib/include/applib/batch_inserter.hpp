@@ -0,0 +1,56 @@
+#ifndef APPLIB_BATCH_INSERTER_HPP
+#define APPLIB_BATCH_INSERTER_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The BatchInserter class. Output iterator which collects values to a
+/// batch of fixed capacity and gives full batches to a consumer, so a long
+/// sequence of values is never held at once. The last, not full batch is
+/// left in the batch vector for the caller.
+///
+template <class T, class ConsumerT>
+class BatchInserter {
+public:
+
+    using difference_type = std::ptrdiff_t;
+
+public:
+
+    /**
+     * @brief BatchInserter - inserter constructor.
+     * @param batch - batch to collect to, its capacity is the batch size.
+     * @param consume - called with each full batch.
+     */
+    BatchInserter(std::vector<T>& batch, ConsumerT& consume)
+        : _batch(&batch), _consume(&consume) {}
+
+    /**
+     * @brief operator= - add value to the batch.
+     * @param value - value convertible to T.
+     * @return this inserter.
+     */
+    template <class ValueT>
+    BatchInserter& operator=(const ValueT& value) {
+        _batch->push_back(static_cast<T>(value));
+        if (_batch->size() == _batch->capacity()) {
+            (*_consume)(std::span<const T>(*_batch));
+            _batch->clear();
+        }
+        return *this;
+    }
+
+    BatchInserter& operator*() { return *this; }
+
+    BatchInserter& operator++() { return *this; }
+
+    BatchInserter operator++(int) { return *this; }
+
+private:
+    std::vector<T>* _batch;
+    ConsumerT* _consume;
+};
+
+#endif  // APPLIB_BATCH_INSERTER_HPP
@@ -0,0 +1,32 @@
+#ifndef APPLIB_BITS_UNPACKER_HPP
+#define APPLIB_BITS_UNPACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The BitsUnpacker class. Bulk unpacking of words which are not
+/// aligned to bytes. Bits go in the same order as in BitsWordFlow: the first
+/// bit of a word is the most significant bit of its ord.
+///
+/// Each word is taken by one 64-bit unaligned load and two shifts instead of
+/// a loop over its bits. If AVX2 is available at runtime, words are unpacked
+/// by eight with gathers and per-lane shifts.
+///
+class BitsUnpacker {
+public:
+
+    /**
+     * @brief unpack - get ords of first ords.size() words of data.
+     * @param data - bytes to take words from.
+     * @param numBits - word bits count, from 1 to 32. Ord type must hold it.
+     * @param ords - where to put ords, data must hold all of them.
+     */
+    template <class OrdT>
+    static void unpack(std::span<const std::byte> data,
+                       std::uint16_t numBits,
+                       std::span<OrdT> ords);
+};
+
+#endif  // APPLIB_BITS_UNPACKER_HPP
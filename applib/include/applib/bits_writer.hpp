@@ -0,0 +1,82 @@
+#ifndef APPLIB_BITS_WRITER_HPP
+#define APPLIB_BITS_WRITER_HPP
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The BitsWriter class. Writes bits to a preallocated buffer through a
+/// 64-bit accumulator, the first bit goes to the most significant bit of the
+/// first byte. Inverse of BitsUnpacker and BytesUnpacker.
+///
+class BitsWriter {
+public:
+
+    /**
+     * @brief BitsWriter - writer constructor.
+     * @param out - buffer to write to, must hold all written bits.
+     */
+    explicit BitsWriter(std::span<std::byte> out) : _out(out) {}
+
+    /**
+     * @brief put - write lowest bits of a value.
+     * @param bits - value, bits higher than count must be zero.
+     * @param count - bits count, up to 32.
+     */
+    void put(std::uint64_t bits, std::uint16_t count);
+
+    /**
+     * @brief putOrds - write ords of numBits bits words. Byte-aligned words
+     * are written with vector shuffles if the writer is on a byte boundary.
+     * @param ords - ords to write.
+     * @param numBits - word bits count, from 1 to 32. Ord type must hold it.
+     * Throws std::runtime_error if ords do not fit in the buffer.
+     */
+    template <class OrdT>
+    void putOrds(std::span<const OrdT> ords, std::uint16_t numBits);
+
+    /**
+     * @brief finish - write the last partial byte, padded with zeros.
+     * @return written bytes count.
+     */
+    std::size_t finish();
+
+private:
+
+    void _store32(std::uint32_t value);
+
+    void _flushBytes();
+
+private:
+    std::span<std::byte> _out;
+    std::size_t _pos{0};         // Bytes written to out.
+    std::uint64_t _acc{0};       // Lowest _accBits are not written yet.
+    std::uint16_t _accBits{0};   // Always less than 32 between calls.
+};
+
+////////////////////////////////////////////////////////////////////////////////
+inline void BitsWriter::put(std::uint64_t bits, std::uint16_t count) {
+    assert(count <= 32 && "Too many bits.");
+    _acc = (_acc << count) | bits;
+    _accBits += count;
+    if (_accBits >= 32) {
+        _accBits -= 32;
+        _store32(static_cast<std::uint32_t>(_acc >> _accBits));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void BitsWriter::_store32(std::uint32_t value) {
+    assert(_pos + 4 <= _out.size() && "Out of buffer.");
+    if constexpr (std::endian::native == std::endian::little) {
+        value = __builtin_bswap32(value);
+    }
+    std::memcpy(_out.data() + _pos, &value, sizeof(value));
+    _pos += sizeof(value);
+}
+
+#endif  // APPLIB_BITS_WRITER_HPP
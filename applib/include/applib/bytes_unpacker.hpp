@@ -0,0 +1,31 @@
+#ifndef APPLIB_BYTES_UNPACKER_HPP
+#define APPLIB_BYTES_UNPACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The BytesUnpacker class. Bulk unpacking of words of whole bytes.
+/// Bytes go in the same order as in BytesWordFlow: the first byte of a word is
+/// the most significant byte of its ord.
+///
+/// Two, three and four bytes words are byte-swapped by shuffles of 32 bytes
+/// (AVX2) or 16 bytes (SSSE3) at once if the processor supports it.
+///
+class BytesUnpacker {
+public:
+
+    /**
+     * @brief unpack - get ords of first ords.size() words of data.
+     * @param data - bytes to take words from.
+     * @param numBytes - word bytes count, from 1 to 4. Ord type must hold it.
+     * @param ords - where to put ords, data must hold all of them.
+     */
+    template <class OrdT>
+    static void unpack(std::span<const std::byte> data,
+                       std::uint8_t numBytes,
+                       std::span<OrdT> ords);
+};
+
+#endif  // APPLIB_BYTES_UNPACKER_HPP
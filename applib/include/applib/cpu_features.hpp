@@ -0,0 +1,27 @@
+#ifndef APPLIB_CPU_FEATURES_HPP
+#define APPLIB_CPU_FEATURES_HPP
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define APPLIB_HAS_X86_KERNELS
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The CpuFeatures class. Runtime checks of instruction sets used by
+/// vectorized kernels. Kernels are built with target attributes, so they are
+/// only called if the check passes.
+///
+struct CpuFeatures {
+    /**
+     * @brief hasSsse3 - check if SSSE3 kernels can be used.
+     * @return true if supported by this build and processor.
+     */
+    static bool hasSsse3();
+
+    /**
+     * @brief hasAvx2 - check if AVX2 kernels can be used.
+     * @return true if supported by this build and processor.
+     */
+    static bool hasAvx2();
+};
+
+#endif  // APPLIB_CPU_FEATURES_HPP
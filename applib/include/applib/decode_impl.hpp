@@ -1,71 +1,406 @@
 #ifndef APPLIB_DECODE_IMPL_HPP
 #define APPLIB_DECODE_IMPL_HPP
 
+#include <algorithm>
 #include <cstdint>
+#include <deque>
+#include <future>
+#include <limits>
+#include <optional>
 #include <ostream>
+#include <span>
+#include <stdexcept>
+#include <variant>
 #include <vector>
 
-#include <indicators/progress_bar.hpp>
-
 #include <ael/arithmetic_decoder.hpp>
 #include <ael/data_parser.hpp>
 
+#include "batch_impl.hpp"
+#include "batch_inserter.hpp"
+#include "bits_writer.hpp"
 #include "file_opener.hpp"
+#include "frames_layout.hpp"
+#include "out_stream_sink.hpp"
+#include "progress_meter.hpp"
+#include "range_coder.hpp"
+#include "stats.hpp"
+#include "thread_pool.hpp"
 #include "word_packer.hpp"
+#include "words_and_flow.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief The DecodeImpl class. Includes decode steps.
 ///
 struct DecodeImpl {
+    struct Options {
+        std::size_t threadsCount{1};
+        std::uint64_t offset{0};
+        std::uint64_t length{std::numeric_limits<std::uint64_t>::max()};
+    };
+
     struct ConfigureRet {
+        std::ostream& outStream;
+        std::vector<BatchImpl::Job> jobs;
+        BatchImpl::Options batchOptions;
+        Options options;
+    };
+
+    struct File {
         std::ostream& outStream;
         FileOpener fileOpener;
         ael::DataParser decoded;
     };
 
-    static std::ostream nullOut;
-
     static ConfigureRet configure(int argc, char* argv[]);
 
-    static void process(ael::DataParser& decoded,
-                        auto& dict,
-                        std::size_t wordsCount,
-                        std::size_t bitsCount,
+    static File openFile(const BatchImpl::Job& job,
+                         std::ostream& logStream,
+                         Stats& stats);
+
+    static void process(std::span<const std::byte> inData,
+                        auto makeDict,
                         std::uint16_t symBitLen,
-                        std::uint16_t tailSize,
-                        std::ostream& bytesOutStream,
-                        std::ostream& optLogOutStream);
+                        const Options& options,
+                        FileOpener& fileOpener,
+                        std::ostream& optLogOutStream,
+                        Stats& stats);
+
+    /**
+     * @brief processFrames - decode frames with any frame decoder.
+     * @param inData - encoded data.
+     * @param makeFrameDecoder - takes frames layout and makes a frame
+     * decoder: a callable taking frame data, frame record, ords output
+     * iterator and tick. One decoder decodes all frames in order if block
+     * size is zero, otherwise each block gets its own decoder.
+     * @param symBitLen - word bits count.
+     * @param options - decode options.
+     * @param fileOpener - opener of output file.
+     * @param optLogOutStream - log stream.
+     * @param stats - stats to time and count to.
+     */
+    static void processFrames(std::span<const std::byte> inData,
+                              auto makeFrameDecoder,
+                              std::uint16_t symBitLen,
+                              const Options& options,
+                              FileOpener& fileOpener,
+                              std::ostream& optLogOutStream,
+                              Stats& stats);
+
+    /**
+     * @brief packDecoded - run a decoder and pack ords it gives to the writer
+     * by batches, so decoded ords are never held all at once.
+     * @param decode - decoder call taking ords output iterator.
+     * @param ords - empty vector of ord type to collect batches to.
+     * @param wordsCount - count of words the decoder gives.
+     * @param writer - writer of output buffer.
+     * @param symBitLen - word bits count.
+     * @param stats - stats to time decoding and packing to.
+     */
+    static void packDecoded(auto decode,
+                            auto& ords,
+                            std::uint64_t wordsCount,
+                            BitsWriter& writer,
+                            std::uint16_t symBitLen,
+                            Stats& stats);
+
+private:
+
+    constexpr static std::size_t _packBatchSize = 1 << 14;
+
+    /*
+     * Decoded data is split into pieces: piece i is the output of frame i,
+     * the last piece also includes the tail. If there are no frames, the only
+     * piece is the tail.
+     */
+    struct _Pieces {
+        std::vector<std::uint64_t> bounds;       // Output bytes offsets.
+        std::vector<std::uint64_t> dataOffsets;  // Frames bytes offsets.
+
+        std::size_t size() const { return bounds.size() - 1; }
+    };
+
+    static _Pieces _getPieces(const FramesLayout& layout,
+                              std::uint16_t symBitLen);
+
+    static std::vector<std::byte> _decodePieceTo(
+        std::size_t i,
+        const FramesLayout& layout,
+        const _Pieces& pieces,
+        std::span<const std::byte> framesData,
+        auto& frameDecoder,
+        std::uint16_t symBitLen,
+        auto tick,
+        Stats& stats,
+        std::uint64_t begin,
+        std::uint64_t end,
+        std::span<std::byte> outData);
+
+    static void _decodePiece(std::size_t i,
+                             const FramesLayout& layout,
+                             const _Pieces& pieces,
+                             std::span<const std::byte> framesData,
+                             auto& frameDecoder,
+                             std::uint16_t symBitLen,
+                             auto tick,
+                             Stats& stats,
+                             std::span<std::byte> out);
+
+    static void _putPiece(std::vector<std::byte>&& pieceData,
+                          std::uint64_t outOffset,
+                          std::optional<OutStreamSink>& sink,
+                          std::span<std::byte> outData);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
-void DecodeImpl::process(ael::DataParser &decoded,
-                         auto &dict,
-                         std::size_t wordsCount,
-                         std::size_t bitsCount,
+void DecodeImpl::process(std::span<const std::byte> inData,
+                         auto makeDict,
                          std::uint16_t symBitLen,
-                         std::uint16_t tailSize,
-                         std::ostream& bytesOutStream,
-                         std::ostream& optLogOutStream) {
-    auto dataConstructor = ael::ByteDataConstructor();
-    
-    std::vector<std::uint64_t> ords;
-    
-    auto progressBar = indicators::ProgressBar(
-        indicators::option::BarWidth{50},
-        indicators::option::MaxProgress{wordsCount},
-        indicators::option::ShowPercentage{true},
-        indicators::option::PostfixText{"Decoding"},
-        indicators::option::Stream{optLogOutStream});
-    ael::ArithmeticDecoder::decode(
-        decoded, dict, std::back_inserter(ords),
-        wordsCount, bitsCount, [&progressBar](){ progressBar.tick(); });
-    
-    WordPacker::process(ords, dataConstructor, symBitLen);
-    
-    std::copy(decoded.getEndBitsIter() - tailSize, decoded.getEndBitsIter(),
-              dataConstructor.getBitBackInserter());
-    
-    bytesOutStream.write(dataConstructor.data<char>(), dataConstructor.size());
+                         const Options& options,
+                         FileOpener& fileOpener,
+                         std::ostream& optLogOutStream,
+                         Stats& stats) {
+    stats.measureDict(makeDict);
+    const auto makeFrameDecoder = [&](const FramesLayout& layout) {
+        if (layout.coder == FramesLayout::Coder::Rans
+                || layout.coder == FramesLayout::Coder::Huffman) {
+            throw std::runtime_error("Data is coded without dictionaries.");
+        }
+        return [dict = makeDict(), coder = layout.coder,
+                statesCount = layout.statesCount](
+                std::span<const std::byte> frameData,
+                const FramesLayout::Frame& frame,
+                auto ordsOut,
+                auto tick) mutable {
+            if (coder == FramesLayout::Coder::Range) {
+                RangeCoder::decode(frameData, dict, ordsOut, frame.wordsCount,
+                                   tick, statesCount);
+                return;
+            }
+            auto decoded = ael::DataParser(frameData);
+            ael::ArithmeticDecoder::decode(decoded, dict, ordsOut,
+                                           frame.wordsCount, frame.bitsCount,
+                                           tick);
+        };
+    };
+    processFrames(inData, makeFrameDecoder, symBitLen, options, fileOpener,
+                  optLogOutStream, stats);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DecodeImpl::processFrames(std::span<const std::byte> inData,
+                               auto makeFrameDecoder,
+                               std::uint16_t symBitLen,
+                               const Options& options,
+                               FileOpener& fileOpener,
+                               std::ostream& optLogOutStream,
+                               Stats& stats) {
+    const auto layout = FramesLayout::takeFrom(inData, symBitLen);
+    optLogOutStream << "Coder: " << layout.coder << std::endl
+                    << "Coder states: "
+                    << static_cast<unsigned>(layout.statesCount) << std::endl
+                    << "Words count: " << layout.wordsCount << std::endl
+                    << "Frames count: " << layout.frames.size() << std::endl
+                    << "Block size: " << layout.blockSize << std::endl
+                    << "Tail size: " << layout.tailSize << std::endl;
+
+    const auto pieces = _getPieces(layout, symBitLen);
+    const auto decodedSize = pieces.bounds.back();
+    if (options.offset > decodedSize) {
+        throw std::runtime_error("Offset is out of decoded data.");
+    }
+    const auto begin = options.offset;
+    const auto end = begin + std::min(options.length, decodedSize - begin);
+    if (begin == end) {
+        return;
+    }
+
+    // Only pieces intersecting [begin, end) are needed.
+    const auto firstPiece = static_cast<std::size_t>(
+        std::upper_bound(pieces.bounds.begin(), pieces.bounds.end() - 1, begin)
+        - pieces.bounds.begin() - 1);
+    const auto lastPiece = static_cast<std::size_t>(
+        std::lower_bound(pieces.bounds.begin() + 1, pieces.bounds.end(), end)
+        - pieces.bounds.begin());
+
+    // Frames sharing a model have to be decoded from the first one.
+    const auto decodeFrom = layout.hasIndependentFrames() ? firstPiece : 0;
+    std::uint64_t wordsToDecode = 0;
+    for (std::size_t i = decodeFrom;
+            i < std::min(lastPiece, layout.frames.size()); ++i) {
+        wordsToDecode += layout.frames[i].wordsCount;
+    }
+
+    auto progress = ProgressMeter(optLogOutStream, "Decoding",
+                                  wordsToDecode, symBitLen / 8.);
+    stats.addWords(wordsToDecode);
+    stats.addBytesOut(end - begin);
+    stats.setBitsPerWord(symBitLen);
+
+    const auto framesData = layout.getFramesData(inData);
+    // Pieces are decoded right into the output file if it can be mapped.
+    const auto outData = fileOpener.mapOutData(end - begin);
+    auto sink = std::optional<OutStreamSink>();
+    if (outData.empty()) {
+        sink.emplace(fileOpener.getOutFileStream());
+    }
+    const auto getOutOffset = [&](std::size_t i) {
+        return std::max(begin, pieces.bounds[i]) - begin;
+    };
+    // Once piece i is written, input and output before it are not needed.
+    const auto framesOffset =
+        static_cast<std::size_t>(framesData.data() - inData.data());
+    const auto release = [&](std::size_t i) {
+        if (i < layout.frames.size()) {
+            fileOpener.releaseInData(framesOffset + pieces.dataOffsets[i]
+                                     + layout.frames[i].bytesCount);
+        }
+        fileOpener.releaseOutData(getOutOffset(i + 1));
+    };
+
+    if (layout.blockSize == 0) {
+        auto frameDecoder = makeFrameDecoder(layout);
+        for (std::size_t i = decodeFrom; i < lastPiece; ++i) {
+            auto pieceData = _decodePieceTo(
+                i, layout, pieces, framesData, frameDecoder, symBitLen,
+                progress.getTick(), stats, begin, end, outData);
+            auto timer = stats.time(Stats::Phase::Write);
+            _putPiece(std::move(pieceData), getOutOffset(i), sink, outData);
+            release(i);
+        }
+    } else {
+        // Independent blocks are decoded in parallel and written in order.
+        auto pool = ThreadPool(options.threadsCount);
+        auto pending = std::deque<std::future<std::vector<std::byte>>>();
+        std::size_t nextToWrite = firstPiece;
+        std::uint64_t wordsDecoded = 0;
+
+        const auto writeFirstPending = [&] {
+            auto pieceData = pending.front().get();
+            auto timer = stats.time(Stats::Phase::Write);
+            _putPiece(std::move(pieceData), getOutOffset(nextToWrite), sink,
+                      outData);
+            release(nextToWrite);
+            pending.pop_front();
+            if (nextToWrite < layout.frames.size()) {
+                wordsDecoded += layout.frames[nextToWrite].wordsCount;
+            }
+            ++nextToWrite;
+            progress.set(wordsDecoded);
+        };
+
+        for (std::size_t i = firstPiece; i < lastPiece; ++i) {
+            pending.push_back(pool.submit(
+                [i, &layout, &pieces, framesData, &makeFrameDecoder,
+                        symBitLen, &stats, begin, end, outData] {
+                    auto frameDecoder = makeFrameDecoder(layout);
+                    return _decodePieceTo(i, layout, pieces, framesData,
+                                          frameDecoder, symBitLen, []{}, stats,
+                                          begin, end, outData);
+                }));
+            if (pending.size() >= 2 * pool.size()) {
+                writeFirstPending();
+            }
+        }
+        while (!pending.empty()) {
+            writeFirstPending();
+        }
+    }
+    if (sink) {
+        auto timer = stats.time(Stats::Phase::Write);
+        sink->finish();
+    }
+    progress.finish();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DecodeImpl::packDecoded(auto decode,
+                             auto& ords,
+                             std::uint64_t wordsCount,
+                             BitsWriter& writer,
+                             std::uint16_t symBitLen,
+                             Stats& stats) {
+    ords.reserve(std::min<std::uint64_t>(wordsCount, _packBatchSize));
+    // Timers are switched by batches to keep decoding and packing apart.
+    auto codeTimer = std::optional<Stats::Timer>();
+    const auto pack = [&](const auto& batch) {
+        codeTimer.reset();
+        {
+            auto timer = stats.time(Stats::Phase::Pack);
+            WordPacker::process(batch, writer, symBitLen);
+        }
+        codeTimer.emplace(stats, Stats::Phase::Code);
+    };
+    codeTimer.emplace(stats, Stats::Phase::Code);
+    decode(BatchInserter(ords, pack));
+    codeTimer.reset();
+    auto timer = stats.time(Stats::Phase::Pack);
+    WordPacker::process(ords, writer, symBitLen);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::byte> DecodeImpl::_decodePieceTo(
+        std::size_t i,
+        const FramesLayout& layout,
+        const _Pieces& pieces,
+        std::span<const std::byte> framesData,
+        auto& frameDecoder,
+        std::uint16_t symBitLen,
+        auto tick,
+        Stats& stats,
+        std::uint64_t begin,
+        std::uint64_t end,
+        std::span<std::byte> outData) {
+    const auto pieceBegin = pieces.bounds[i];
+    const auto pieceEnd = pieces.bounds[i + 1];
+    if (!outData.empty() && begin <= pieceBegin && pieceEnd <= end) {
+        _decodePiece(i, layout, pieces, framesData, frameDecoder, symBitLen,
+                     tick, stats, outData.subspan(pieceBegin - begin,
+                                            pieceEnd - pieceBegin));
+        return {};
+    }
+
+    // Only the first and the last pieces of a range are clipped, and frames
+    // before the range when they share a dictionary.
+    auto ret = std::vector<std::byte>(pieceEnd - pieceBegin);
+    _decodePiece(i, layout, pieces, framesData, frameDecoder, symBitLen, tick,
+                 stats, ret);
+    const auto from = std::clamp(begin, pieceBegin, pieceEnd);
+    const auto to = std::clamp(end, from, pieceEnd);
+    ret.erase(ret.begin() + (to - pieceBegin), ret.end());
+    ret.erase(ret.begin(), ret.begin() + (from - pieceBegin));
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DecodeImpl::_decodePiece(std::size_t i,
+                              const FramesLayout& layout,
+                              const _Pieces& pieces,
+                              std::span<const std::byte> framesData,
+                              auto& frameDecoder,
+                              std::uint16_t symBitLen,
+                              auto tick,
+                              Stats& stats,
+                              std::span<std::byte> out) {
+    auto writer = BitsWriter(out);
+
+    if (i < layout.frames.size()) {
+        const auto& frame = layout.frames[i];
+        const auto frameData =
+            framesData.subspan(pieces.dataOffsets[i], frame.bytesCount);
+        auto wordsOrds = makeWordsOrds(symBitLen);
+        std::visit([&](auto& ords) {
+            packDecoded([&](auto ordsOut) {
+                frameDecoder(frameData, frame, ordsOut, tick);
+            }, ords, frame.wordsCount, writer, symBitLen, stats);
+        }, wordsOrds);
+    }
+
+    // Only the last frame may end not on a byte boundary.
+    if (i + 1 == pieces.size()) {
+        writer.put(layout.tail, layout.tailSize);
+    }
+    writer.finish();
 }
 
 #endif  // APPLIB_DECODE_IMPL_HPP
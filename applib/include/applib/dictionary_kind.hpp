@@ -0,0 +1,44 @@
+#ifndef APPLIB_DICTIONARY_KIND_HPP
+#define APPLIB_DICTIONARY_KIND_HPP
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The DictionaryKind enum. Cumulative counts structure of adaptive
+/// dictionaries. Archievers write it to the header.
+///
+enum class DictionaryKind : std::uint8_t {
+    SegmentTree,  // ael dictionaries, any word bits count.
+    Fenwick       // Fenwick dictionaries, dense alphabets up to 2^16 words.
+};
+
+constexpr std::uint16_t fenwickMaxWordBits = 16;
+
+/**
+ * @brief takeDictionaryKind - check dictionary kind read from a header.
+ * @param value - written dictionary kind.
+ * @param numBits - word bits count.
+ * @return dictionary kind.
+ */
+DictionaryKind takeDictionaryKind(std::uint8_t value, std::uint16_t numBits);
+
+/**
+ * @brief operator>> - read dictionary kind name: "segment-tree" or
+ * "fenwick".
+ * @param in - stream to read from.
+ * @param kind - dictionary kind to read to.
+ * @return stream.
+ */
+std::istream& operator>>(std::istream& in, DictionaryKind& kind);
+
+/**
+ * @brief operator<< - write dictionary kind name.
+ * @param out - stream to write to.
+ * @param kind - dictionary kind.
+ * @return stream.
+ */
+std::ostream& operator<<(std::ostream& out, DictionaryKind kind);
+
+#endif  // APPLIB_DICTIONARY_KIND_HPP
@@ -0,0 +1,250 @@
+#ifndef APPLIB_ENCODE_IMPL_HPP
+#define APPLIB_ENCODE_IMPL_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <numeric>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <boost/program_options/options_description.hpp>
+
+#include <ael/arithmetic_coder.hpp>
+#include <ael/byte_data_constructor.hpp>
+
+#include "file_opener.hpp"
+#include "frames_layout.hpp"
+#include "ord_and_tail_splitter.hpp"
+#include "out_stream_sink.hpp"
+#include "progress_meter.hpp"
+#include "range_coder.hpp"
+#include "stats.hpp"
+#include "thread_pool.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The EncodeImpl class. Includes encode steps.
+///
+struct EncodeImpl {
+    struct Options {
+        std::size_t chunkSize;
+        std::size_t blockSize;
+        std::size_t threadsCount;
+        FramesLayout::Coder coder{FramesLayout::Coder::Arithmetic};
+        std::size_t statesCount{1};
+    };
+
+    using EncodedData =
+        std::variant<ael::ByteDataConstructor, std::vector<std::byte>>;
+
+    constexpr static std::size_t defaultChunkSize = std::size_t{1} << 24;
+
+    static void addOptions(boost::program_options::options_description& descr,
+                           Options& options);
+
+    static void addFramesOptions(
+        boost::program_options::options_description& descr,
+        Options& options);
+
+    static void process(FileOpener& fileOpener,
+                        auto makeDict,
+                        std::uint16_t numBits,
+                        const Options& options,
+                        ael::ByteDataConstructor&& header,
+                        std::ostream& optLogOutStream,
+                        Stats& stats);
+
+    /**
+     * @brief processFrames - encode input by frames with any frame coder.
+     * @param fileOpener - opener of input and output files.
+     * @param makeFrameCoder - makes a frame coder: a callable taking ords
+     * vector, encoded data to put to and tick, returning the frame record.
+     * One coder codes all chunks in order if block size is zero, otherwise
+     * each block gets its own coder.
+     * @param numBits - word bits count.
+     * @param options - encode options, the coder is put to the layout.
+     * @param header - data written before frames.
+     * @param optLogOutStream - log stream.
+     * @param stats - stats to time and count to.
+     */
+    static void processFrames(FileOpener& fileOpener,
+                              auto makeFrameCoder,
+                              std::uint16_t numBits,
+                              const Options& options,
+                              ael::ByteDataConstructor&& header,
+                              std::ostream& optLogOutStream,
+                              Stats& stats);
+
+private:
+
+    struct _EncodedChunk {
+        EncodedData data;
+        FramesLayout::Frame frame;
+        OrdAndTailSplitter::Ret::Tail tail;
+    };
+
+    static _EncodedChunk _encodeChunk(std::span<const std::byte> chunk,
+                                      auto& frameCoder,
+                                      std::uint16_t numBits,
+                                      auto tick,
+                                      Stats& stats);
+
+    static void _putChunk(_EncodedChunk&& encodedChunk,
+                          FramesLayout& layout,
+                          OutStreamSink& sink,
+                          Stats& stats);
+
+    static std::size_t _alignChunkSize(std::size_t chunkSize,
+                                       std::uint16_t numBits);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+void EncodeImpl::process(FileOpener& fileOpener,
+                         auto makeDict,
+                         std::uint16_t numBits,
+                         const Options& options,
+                         ael::ByteDataConstructor&& header,
+                         std::ostream& optLogOutStream,
+                         Stats& stats) {
+    if (options.coder == FramesLayout::Coder::Rans
+            || options.coder == FramesLayout::Coder::Huffman) {
+        throw std::runtime_error("Adaptive dictionaries can not be coded "
+                                 "with semi-static coders.");
+    }
+    if (!RangeCoder::isStatesCount(options.statesCount)
+            || (options.statesCount != 1
+                && options.coder != FramesLayout::Coder::Range)) {
+        throw std::runtime_error("Coder states count must be 1, 2, 4 or 8, "
+                                 "more than one only with range coder.");
+    }
+    stats.measureDict(makeDict);
+    const auto makeFrameCoder = [&] {
+        return [dict = makeDict(), coder = options.coder,
+                statesCount = options.statesCount](
+                const auto& ords, EncodedData& data, auto tick) mutable {
+            if (coder == FramesLayout::Coder::Range) {
+                auto& bytes = data.template emplace<std::vector<std::byte>>();
+                auto [wordsCount, bytesCount] = RangeCoder::encode(
+                    ords, bytes, dict, tick, statesCount);
+                return FramesLayout::Frame{wordsCount, bytesCount * 8,
+                                           bytesCount};
+            }
+            auto& bytes = std::get<ael::ByteDataConstructor>(data);
+            auto [wordsCount, bitsCount] = ael::ArithmeticCoder::encode(
+                ords, bytes, dict, tick);
+            return FramesLayout::Frame{wordsCount, bitsCount, bytes.size()};
+        };
+    };
+    processFrames(fileOpener, makeFrameCoder, numBits, options,
+                  std::move(header), optLogOutStream, stats);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void EncodeImpl::processFrames(FileOpener& fileOpener,
+                               auto makeFrameCoder,
+                               std::uint16_t numBits,
+                               const Options& options,
+                               ael::ByteDataConstructor&& header,
+                               std::ostream& optLogOutStream,
+                               Stats& stats) {
+    auto sink = OutStreamSink(fileOpener.getOutFileStream());
+    sink.put(std::move(header));
+
+    // Size of pipes is not known, so progress is not shown for them.
+    const auto inSize = fileOpener.getInSize().value_or(0);
+
+    auto progress = ProgressMeter(optLogOutStream, "Encoding",
+                                  inSize * 8 / numBits, numBits / 8.);
+    stats.setBitsPerWord(numBits);
+
+    auto layout = FramesLayout();
+    layout.coder = options.coder;
+    layout.statesCount = static_cast<std::uint8_t>(options.statesCount);
+
+    if (options.blockSize == 0) {
+        // One model adapts over the whole file, chunks are coded in order.
+        const auto chunkSize = _alignChunkSize(options.chunkSize, numBits);
+        auto frameCoder = makeFrameCoder();
+        std::size_t offset = 0;
+        for (auto chunk = fileOpener.readInChunk(chunkSize);
+                !chunk.data.empty();
+                chunk = fileOpener.readInChunk(chunkSize)) {
+            _putChunk(_encodeChunk(chunk.data, frameCoder, numBits,
+                                   progress.getTick(), stats),
+                      layout, sink, stats);
+            offset += chunk.data.size();
+            fileOpener.releaseInData(offset);
+        }
+    } else {
+        // Independent blocks are coded in parallel and put in order, so
+        // output does not depend on threads count.
+        layout.blockSize = _alignChunkSize(options.blockSize, numBits);
+        auto pool = ThreadPool(options.threadsCount);
+        auto pending = std::deque<std::future<_EncodedChunk>>();
+        std::size_t releaseOffset = 0;
+
+        const auto putFirstPending = [&] {
+            _putChunk(pending.front().get(), layout, sink, stats);
+            pending.pop_front();
+            releaseOffset += layout.blockSize;
+            fileOpener.releaseInData(releaseOffset);
+            progress.set(layout.wordsCount);
+        };
+
+        for (auto block = fileOpener.readInChunk(layout.blockSize);
+                !block.data.empty();
+                block = fileOpener.readInChunk(layout.blockSize)) {
+            pending.push_back(pool.submit([block = std::move(block),
+                                           &makeFrameCoder, numBits,
+                                           &stats] {
+                auto frameCoder = makeFrameCoder();
+                return _encodeChunk(block.data, frameCoder, numBits, []{},
+                                    stats);
+            }));
+            if (pending.size() >= 2 * pool.size()) {
+                putFirstPending();
+            }
+        }
+        while (!pending.empty()) {
+            putFirstPending();
+        }
+    }
+
+    auto table = ael::ByteDataConstructor();
+    layout.putTo(table);
+    {
+        auto timer = stats.time(Stats::Phase::Write);
+        sink.put(std::move(table));
+        sink.finish();
+    }
+    stats.addWords(layout.wordsCount);
+    stats.addBytesOut(sink.getBytesCount());
+    progress.finish();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto EncodeImpl::_encodeChunk(std::span<const std::byte> chunk,
+                              auto& frameCoder,
+                              std::uint16_t numBits,
+                              auto tick,
+                              Stats& stats) -> _EncodedChunk {
+    auto [wordsOrds, tail] = [&] {
+        auto timer = stats.time(Stats::Phase::Split);
+        return OrdAndTailSplitter::process(chunk, numBits);
+    }();
+    auto ret = _EncodedChunk{{}, {0, 0, 0}, std::move(tail)};
+    std::visit([&](const auto& ords) {
+        if (!ords.empty()) {
+            auto timer = stats.time(Stats::Phase::Code);
+            ret.frame = frameCoder(ords, ret.data, tick);
+        }
+    }, wordsOrds);
+    return ret;
+}
+
+#endif  // APPLIB_ENCODE_IMPL_HPP
@@ -0,0 +1,258 @@
+#ifndef APPLIB_FENWICK_DICTIONARY_HPP
+#define APPLIB_FENWICK_DICTIONARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The FenwickTree class. Flat Fenwick tree of counts of a dense
+/// alphabet. Size is rounded up to a power of two, so the top-down search
+/// has a fixed number of steps without bounds checks, and the nodes are
+/// cache line aligned.
+///
+class FenwickTree {
+public:
+
+    /**
+     * @brief FenwickTree - tree constructor.
+     * @param size - counts count.
+     * @param initialCount - initial count of each element.
+     */
+    FenwickTree(std::size_t size, std::uint64_t initialCount);
+
+    /**
+     * @brief add - add to a count. Counts are modulo 2^64, so a value
+     * subtracted from a count may be added as its negation.
+     * @param index - element index.
+     * @param value - value to add.
+     */
+    void add(std::size_t index, std::uint64_t value) {
+        for (++index; index <= _size; index += index & (~index + 1)) {
+            _nodes[index] += value;
+        }
+    }
+
+    /**
+     * @brief getLowerCumulative - get sum of counts before an element.
+     * @param index - element index.
+     * @return sum of counts of elements [0, index).
+     */
+    std::uint64_t getLowerCumulative(std::size_t index) const {
+        std::uint64_t ret = 0;
+        for (; index != 0; index &= index - 1) {
+            ret += _nodes[index];
+        }
+        return ret;
+    }
+
+    /**
+     * @brief find - find element by cumulative count.
+     * @param cumulative - cumulative count, less than sum of all counts.
+     * @return element index i, such that sum of counts of [0, i) is not
+     * greater than cumulative, and sum of counts of [0, i] is greater.
+     */
+    std::size_t find(std::uint64_t cumulative) const {
+        std::size_t ret = 0;
+        for (auto step = _size; step != 0; step >>= 1) {
+            const auto node = _nodes[ret + step];
+            // Masks, as compilers make a conditional step a jump.
+            const auto mask = std::uint64_t{0}
+                - static_cast<std::uint64_t>(node <= cumulative);
+            ret += step & mask;
+            cumulative -= node & mask;
+        }
+        return ret;
+    }
+
+private:
+
+    struct _AlignedDelete {
+        void operator()(std::uint64_t* nodes) const {
+            ::operator delete[](nodes, std::align_val_t{_cacheLineSize});
+        }
+    };
+
+    constexpr static std::size_t _cacheLineSize = 64;
+
+private:
+    std::size_t _size;
+    std::unique_ptr<std::uint64_t[], _AlignedDelete> _nodes;  // From one.
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The FenwickProbabilityStats class. Word counts interval, the same
+/// as ael dictionaries give.
+///
+struct FenwickProbabilityStats {
+    std::uint64_t low;
+    std::uint64_t high;
+    std::uint64_t total;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The FenwickDictionary class. Adaptive dictionary of a dense
+/// alphabet on a Fenwick tree. Words start from count one and each
+/// occurrence adds ratio to the count.
+///
+class FenwickDictionary {
+public:
+
+    /**
+     * @brief FenwickDictionary - dictionary constructor.
+     * @param wordsCount - alphabet size.
+     * @param ratio - count added by each word occurrence.
+     */
+    FenwickDictionary(std::uint64_t wordsCount, std::uint64_t ratio);
+
+    /**
+     * @brief getProbabilityStats - get word counts interval and count the
+     * word.
+     * @param ord - word ord.
+     * @return word counts interval.
+     */
+    FenwickProbabilityStats getProbabilityStats(std::uint64_t ord) {
+        const auto low = _tree.getLowerCumulative(ord);
+        const auto ret =
+            FenwickProbabilityStats{low, low + _counts[ord], _total};
+        _tree.add(ord, _ratio);
+        _counts[ord] += _ratio;
+        _total += _ratio;
+        return ret;
+    }
+
+    /**
+     * @brief getWordOrd - get word by cumulative count.
+     * @param cumulative - cumulative count, less than total.
+     * @return word ord.
+     */
+    std::uint64_t getWordOrd(std::uint64_t cumulative) const {
+        return _tree.find(cumulative);
+    }
+
+    /**
+     * @brief getTotalWordsCnt - get total count.
+     * @return total count.
+     */
+    std::uint64_t getTotalWordsCnt() const { return _total; }
+
+private:
+    FenwickTree _tree;
+    std::vector<std::uint64_t> _counts;
+    std::uint64_t _total;
+    std::uint64_t _ratio;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The FenwickEscapeDictionary class. Adaptive dictionary of a dense
+/// alphabet with an escape for unseen words, which are equally probable
+/// after it, on Fenwick trees of seen words weights and of unseen flags.
+///
+/// Method A: seen word weight is its count, escape weight is one.
+/// Method D: seen word weight is twice its count minus one, escape weight is
+/// unique words count.
+///
+/// Total is (seen weights + escape) * unseen words count, so intervals are
+/// integer, or seen weights if all words are seen.
+///
+template <bool isD>
+class FenwickEscapeDictionary {
+public:
+
+    /**
+     * @brief FenwickEscapeDictionary - dictionary constructor.
+     * @param wordsCount - alphabet size.
+     */
+    explicit FenwickEscapeDictionary(std::uint64_t wordsCount)
+        : _seen(wordsCount, 0), _unseen(wordsCount, 1),
+          _counts(wordsCount, 0), _wordsCount(wordsCount) {}
+
+    /**
+     * @brief getProbabilityStats - get word counts interval and count the
+     * word.
+     * @param ord - word ord.
+     * @return word counts interval.
+     */
+    FenwickProbabilityStats getProbabilityStats(std::uint64_t ord) {
+        const auto unseenCount = _wordsCount - _uniqueCount;
+        const auto seenScale = unseenCount == 0 ? 1 : unseenCount;
+        auto ret = FenwickProbabilityStats{0, 0, getTotalWordsCnt()};
+        if (_counts[ord] != 0) {
+            const auto low = _seen.getLowerCumulative(ord);
+            ret.low = low * seenScale;
+            ret.high = (low + _getWeight(_counts[ord])) * seenScale;
+        } else {
+            const auto escape = _getEscape();
+            ret.low = _seenWeight * unseenCount
+                + _unseen.getLowerCumulative(ord) * escape;
+            ret.high = ret.low + escape;
+            _unseen.add(ord, ~std::uint64_t{0});
+            ++_uniqueCount;
+        }
+        const auto added = _getWeight(_counts[ord] + 1)
+            - _getWeight(_counts[ord]);
+        _seen.add(ord, added);
+        _seenWeight += added;
+        ++_counts[ord];
+        return ret;
+    }
+
+    /**
+     * @brief getWordOrd - get word by cumulative count.
+     * @param cumulative - cumulative count, less than total.
+     * @return word ord.
+     */
+    std::uint64_t getWordOrd(std::uint64_t cumulative) const {
+        const auto unseenCount = _wordsCount - _uniqueCount;
+        const auto seenScale = unseenCount == 0 ? 1 : unseenCount;
+        if (cumulative < _seenWeight * seenScale) {
+            return _seen.find(cumulative / seenScale);
+        }
+        return _unseen.find(
+            (cumulative - _seenWeight * unseenCount) / _getEscape());
+    }
+
+    /**
+     * @brief getTotalWordsCnt - get total count.
+     * @return total count.
+     */
+    std::uint64_t getTotalWordsCnt() const {
+        const auto unseenCount = _wordsCount - _uniqueCount;
+        return unseenCount == 0
+            ? _seenWeight
+            : (_seenWeight + _getEscape()) * unseenCount;
+    }
+
+private:
+
+    static std::uint64_t _getWeight(std::uint64_t count) {
+        if constexpr (isD) {
+            return count == 0 ? 0 : 2 * count - 1;
+        } else {
+            return count;
+        }
+    }
+
+    std::uint64_t _getEscape() const {
+        if constexpr (isD) {
+            return _uniqueCount == 0 ? 1 : _uniqueCount;
+        } else {
+            return 1;
+        }
+    }
+
+private:
+    FenwickTree _seen;
+    FenwickTree _unseen;
+    std::vector<std::uint64_t> _counts;
+    std::uint64_t _wordsCount;
+    std::uint64_t _uniqueCount{0};
+    std::uint64_t _seenWeight{0};
+};
+
+using FenwickADictionary = FenwickEscapeDictionary<false>;
+using FenwickDDictionary = FenwickEscapeDictionary<true>;
+
+#endif  // APPLIB_FENWICK_DICTIONARY_HPP
@@ -2,6 +2,9 @@
 #define APPLIB_FILE_OPENER_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <ostream>
 #include <vector>
 #include <string>
@@ -10,6 +13,9 @@
 
 #include <fmt/format.h>
 
+#include "async_reader.hpp"
+#include "stats.hpp"
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief The FilesOpener class
 ///
@@ -21,36 +27,130 @@ public:
      */
     FileOpener(FileOpener&&) = default;
 
+    /// \brief The InChunk class. Piece of input data. Owns data read by
+    /// chunks, refers to data taken whole.
+    struct InChunk {
+        AsyncReader::Chunk owned;
+        std::span<const std::byte> data;
+    };
+
+    constexpr static auto stdStreamName = "-";
+
+public:
+
     /**
-     * @brief FileOpener - opener constructor from two files names.
-     * @param inFileName - input file name.
-     * @param outFileName - output file name.
+     * @brief FileOpener - opener constructor from two files names. Input is
+     * not read until data is asked for: whole by getInData() or by chunks
+     * read ahead by readInChunk().
+     * @param inFileName - input file name, "-" for standard input.
+     * @param outFileName - output file name, "-" for standard output.
      * @param optOs - optional out stream.
+     * @param stats - stats to count open time and input size to.
      */
     FileOpener(const std::string& inFileName,
                const std::string& outFileName,
-               std::ostream& logOs);
+               std::ostream& logOs,
+               Stats& stats);
 
     /**
-     * @brief getInData - get input file data.
+     * @brief getInData - get input file data. Regular files are
+     * memory-mapped, other files (pipes, special files, standard input) are
+     * read into a buffer.
      * @return bytes array view.
      */
-    std::span<const std::byte> getInData() const;
+    std::span<const std::byte> getInData();
+
+    /**
+     * @brief readInChunk - get next piece of input data. Next chunks are
+     * read while this one is processed (see AsyncReader). Input is either
+     * taken by chunks or whole, if it was taken whole, chunks are its views.
+     * @param maxSize - chunk size, the same for all calls. Only the last
+     * chunk may be smaller.
+     * @return chunk, empty at the end of input.
+     */
+    InChunk readInChunk(std::size_t maxSize);
+
+    /**
+     * @brief getInSize - get input size if it is known before reading.
+     * @return size of regular file, nothing for pipes and standard input.
+     */
+    std::optional<std::uint64_t> getInSize() const;
+
+    /**
+     * @brief isInDataMapped - check if input data is memory-mapped.
+     * @return true if input data is a view of mapped pages.
+     */
+    bool isInDataMapped() const;
+
+    /**
+     * @brief releaseInData - tell that input data before offset is not going
+     * to be read anymore. Mapped pages are given back to keep resident memory
+     * bounded. Does nothing for buffered input and for input read by
+     * chunks, whose buffers are reused once chunks are destroyed.
+     * @param offset - bytes offset of the first byte which is still needed.
+     */
+    void releaseInData(std::size_t offset);
 
     /**
      * @brief getOutFileStream - get output stream reference.
-     * @return
+     * @return output file stream or standard output.
+     */
+    std::ostream& getOutFileStream();
+
+    /**
+     * @brief mapOutData - resize output file to its final size and map it to
+     * memory, so output is written in place instead of the stream. Only
+     * regular files can be mapped. The mapping lives as long as the opener.
+     * @param size - output size in bytes.
+     * @return writable view of output file, empty if it can not be mapped.
+     */
+    std::span<std::byte> mapOutData(std::uint64_t size);
+
+    /**
+     * @brief releaseOutData - tell that mapped output before offset is
+     * written. Its pages are left to the page cache to keep resident memory
+     * bounded. Does nothing if output is not mapped.
+     * @param offset - bytes offset of the first byte which is still written.
      */
-    std::ofstream& getOutFileStream();
+    void releaseOutData(std::size_t offset);
 
 private:
 
-    std::vector<std::byte> _openInFile(const std::string& fileInName,
-                                       std::ostream& logOs);
+    struct _Unmapper {
+        std::size_t size;
+        void operator()(const std::byte* ptr) const;
+    };
+
+    using _MappedData = std::unique_ptr<const std::byte, _Unmapper>;
+    using _MappedOutData = std::unique_ptr<std::byte, _Unmapper>;
+
+private:
+
+    static _MappedData _mapInFile(const std::string& fileInName);
+
+    static _MappedOutData _mapOutFile(const std::string& fileOutName,
+                                      std::uint64_t size);
+
+    static std::vector<std::byte> _openInFile(const std::string& fileInName);
+
+    static std::size_t _readStream(std::istream& in,
+                                   std::vector<std::byte>& out,
+                                   std::size_t maxSize);
 
 private:
+    std::string _inFileName;
+    std::optional<std::uint64_t> _inSize;
+    _MappedData _finMapped;
     std::vector<std::byte> _finData;
+    std::span<const std::byte> _inData;
+    bool _inLoaded{false};
+    std::size_t _inChunkOffset{0};
+    std::unique_ptr<AsyncReader> _reader;
+    std::string _outFileName;
+    bool _outStreamed;
     std::ofstream _fout;
+    _MappedOutData _foutMapped;
+    Stats* _stats;
 };
 
 #endif  // APPLIB_FILE_OPENER_HPP
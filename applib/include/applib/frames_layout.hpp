@@ -0,0 +1,111 @@
+#ifndef APPLIB_FRAMES_LAYOUT_HPP
+#define APPLIB_FRAMES_LAYOUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include <ael/byte_data_constructor.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The FramesLayout class. Encoded data is a sequence of frames. Each
+/// frame is encoded by a separate coder call and starts from a byte boundary.
+/// Frames are followed by the frames table and a fixed size trailer:
+///
+/// | frame 0 | ... | frame n-1 | table (n records) | trailer |
+///
+/// So the layout can be read from the end without knowing the size of the
+/// header written before the frames.
+///
+/// If block size is not zero, each frame is an independent block: it encodes
+/// blockSize input bytes (except the last one) with a fresh dictionary.
+/// Otherwise frames share one dictionary and must be decoded in order,
+/// unless the coder is semi-static and each frame carries its own table.
+///
+struct FramesLayout {
+    enum class Coder : std::uint8_t {
+        Arithmetic,  // Bit-wise ael arithmetic coder.
+        Range,       // Byte-wise RangeCoder.
+        Rans,        // Semi-static RansCoder, no dictionaries.
+        Huffman      // Semi-static HuffmanCoder, no dictionaries.
+    };
+
+    struct Frame {
+        std::uint64_t wordsCount;
+        std::uint64_t bitsCount;
+        std::uint64_t bytesCount;
+    };
+
+    std::vector<Frame> frames;
+    std::uint64_t wordsCount{0};
+    std::uint64_t blockSize{0};
+    std::uint16_t tailSize{0};
+    std::uint32_t tail{0};  // Tail bits, the last one is the least significant.
+    Coder coder{Coder::Arithmetic};
+    std::uint8_t statesCount{1};  // Interleaved states of the range coder.
+
+    /**
+     * @brief putTo - put frames table and trailer after the frames.
+     * @param dataConstructor - data constructor to put to.
+     */
+    void putTo(ael::ByteDataConstructor& dataConstructor) const;
+
+    /**
+     * @brief takeFrom - read frames table and trailer from the end of data.
+     * Counts are checked against data size and word size.
+     * @param data - whole encoded data.
+     * @param symBitLen - word bits count.
+     * @return frames layout.
+     */
+    static FramesLayout takeFrom(std::span<const std::byte> data,
+                                 std::uint16_t symBitLen);
+
+    /**
+     * @brief hasIndependentFrames - check if a frame may be decoded without
+     * the frames before it: frames are blocks or carry their own tables.
+     * @return true if frames are independent.
+     */
+    bool hasIndependentFrames() const;
+
+    /**
+     * @brief getFramesData - get bytes of all frames.
+     * @param data - whole encoded data.
+     * @return bytes of frames, starting from the first frame.
+     */
+    std::span<const std::byte>
+    getFramesData(std::span<const std::byte> data) const;
+
+    /**
+     * @brief getFramesBytesCount - get frames bytes count.
+     * @return sum of frames bytes counts.
+     */
+    std::size_t getFramesBytesCount() const;
+
+    /**
+     * @brief getTableBytesCount - get bytes count of table and trailer.
+     * @return bytes count.
+     */
+    std::size_t getTableBytesCount() const;
+};
+
+/**
+ * @brief operator>> - read coder name: "arithmetic", "range", "rans" or
+ * "huffman".
+ * @param in - stream to read from.
+ * @param coder - coder to read to.
+ * @return stream.
+ */
+std::istream& operator>>(std::istream& in, FramesLayout::Coder& coder);
+
+/**
+ * @brief operator<< - write coder name.
+ * @param out - stream to write to.
+ * @param coder - coder.
+ * @return stream.
+ */
+std::ostream& operator<<(std::ostream& out, FramesLayout::Coder coder);
+
+#endif  // APPLIB_FRAMES_LAYOUT_HPP
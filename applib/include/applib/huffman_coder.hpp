@@ -0,0 +1,259 @@
+#ifndef APPLIB_HUFFMAN_CODER_HPP
+#define APPLIB_HUFFMAN_CODER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The HuffmanCoder class. Semi-static canonical Huffman coder of
+/// words up to 16 bits. Code lengths of a frame are limited to 20 bits and
+/// stored before the codes, which are written from the most significant bit.
+///
+/// The decoder looks up 11 bits at once in a table giving one or two words
+/// whose codes fit there, longer codes are decoded canonically. Bits are
+/// read by 64-bit loads at any bit position, so there is no refill state.
+///
+/// Frame: | symbols count | (symbol, code length) ... | codes |, numbers are
+/// little-endian.
+///
+class HuffmanCoder {
+public:
+
+    struct EncodeRet {
+        std::uint64_t wordsCount;
+        std::uint64_t bytesCount;
+    };
+
+    constexpr static std::uint16_t maxWordBits = 16;
+    constexpr static std::uint8_t maxCodeBits = 20;
+    constexpr static std::uint8_t lookupBits = 11;
+
+public:
+
+    /**
+     * @brief encode - count words frequencies and encode words ords.
+     * @param ords - ords vector of 8-bit or 16-bit unsigned words.
+     * @param out - bytes vector to append frame to.
+     * @param tick - called after each word.
+     * @return words and frame bytes counts.
+     */
+    static EncodeRet encode(const auto& ords,
+                            std::vector<std::byte>& out,
+                            auto tick);
+
+    /**
+     * @brief decode - decode words ords of a frame.
+     * @param data - frame bytes.
+     * @param outIter - ords output iterator.
+     * @param wordsCount - count of words to decode.
+     * @param tick - called after each word.
+     */
+    static void decode(std::span<const std::byte> data,
+                       auto outIter,
+                       std::uint64_t wordsCount,
+                       auto tick);
+
+private:
+
+    struct _Table {
+        std::vector<std::uint16_t> symbols;  // Ascending.
+        std::vector<std::uint8_t> lengths;
+    };
+
+    struct _Entry {
+        std::array<std::uint16_t, 2> symbols;
+        std::uint8_t count;      // Zero for codes longer than lookup bits.
+        std::uint8_t firstBits;  // Code length of the first symbol.
+        std::uint8_t bits;       // Code lengths of all symbols.
+    };
+
+    struct _Decoder {
+        std::vector<_Entry> entries;
+        std::array<std::uint32_t, maxCodeBits + 1> firstCodes;
+        std::array<std::uint32_t, maxCodeBits + 1> counts;
+        std::array<std::uint32_t, maxCodeBits + 1> firstIndices;
+        std::vector<std::uint16_t> sortedSymbols;
+    };
+
+    class _BitsWriter;
+    class _BitsReader;
+
+private:
+
+    static _Table _makeTable(std::span<const std::uint32_t> counts);
+
+    static std::vector<std::uint32_t> _makeCodes(const _Table& table);
+
+    static void _putTable(const _Table& table, std::vector<std::byte>& out);
+
+    static _Table _takeTable(std::span<const std::byte> data,
+                             std::size_t& pos);
+
+    static _Decoder _makeDecoder(const _Table& table);
+
+    static std::uint16_t _decodeLong(const _Decoder& decoder,
+                                     std::uint64_t window,
+                                     std::uint8_t& bits);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The HuffmanCoder::_BitsWriter class. Writes codes from the most
+/// significant bit by 32-bit portions.
+///
+class HuffmanCoder::_BitsWriter {
+public:
+
+    explicit _BitsWriter(std::vector<std::byte>& out) : _out(out) {}
+
+    void put(std::uint32_t code, std::uint8_t bits) {
+        _buffer = (_buffer << bits) | code;
+        _bitsCount += bits;
+        if (_bitsCount >= 32) {
+            _bitsCount -= 32;
+            _putBytes(static_cast<std::uint32_t>(_buffer >> _bitsCount), 4);
+        }
+    }
+
+    void finish() {
+        const auto bytesCount = (_bitsCount + 7) / 8;
+        _putBytes(static_cast<std::uint32_t>(
+            _buffer << (8 * bytesCount - _bitsCount)), bytesCount);
+        _bitsCount = 0;
+    }
+
+private:
+
+    void _putBytes(std::uint32_t value, std::uint8_t bytesCount) {
+        for (std::uint8_t i = bytesCount; i-- != 0;) {
+            _out.push_back(static_cast<std::byte>(value >> (8 * i)));
+        }
+    }
+
+private:
+    std::vector<std::byte>& _out;
+    std::uint64_t _buffer{0};
+    std::uint8_t _bitsCount{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The HuffmanCoder::_BitsReader class. Gives 64 bits starting from
+/// the current bit, at least 57 of them are data. Bits after the end of data
+/// are zeros.
+///
+class HuffmanCoder::_BitsReader {
+public:
+
+    _BitsReader(std::span<const std::byte> data, std::size_t pos)
+        : _data(data), _bitPos(8 * pos) {}
+
+    std::uint64_t peek() const {
+        const auto pos = _bitPos / 8;
+        std::uint64_t ret = 0;
+        if (pos + 8 <= _data.size()) {
+            // Compiles to one load and a byte swap.
+            for (std::size_t i = 0; i < 8; ++i) {
+                ret <<= 8;
+                ret |= std::to_integer<std::uint64_t>(_data[pos + i]);
+            }
+        } else {
+            for (std::size_t i = 0; i < 8; ++i) {
+                ret <<= 8;
+                if (pos + i < _data.size()) {
+                    ret |= std::to_integer<std::uint64_t>(_data[pos + i]);
+                }
+            }
+        }
+        return ret << (_bitPos % 8);
+    }
+
+    void skip(std::uint8_t bits) { _bitPos += bits; }
+
+private:
+    std::span<const std::byte> _data;
+    std::uint64_t _bitPos;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+auto HuffmanCoder::encode(const auto& ords,
+                          std::vector<std::byte>& out,
+                          auto tick) -> EncodeRet {
+    using OrdT = std::ranges::range_value_t<decltype(ords)>;
+    if constexpr (sizeof(OrdT) * 8 > maxWordBits) {
+        throw std::invalid_argument("Huffman coder words are up to 16 bits.");
+    } else {
+        const auto startSize = out.size();
+        auto counts = std::vector<std::uint32_t>(
+            std::size_t{1} << (8 * sizeof(OrdT)));
+        for (const auto ord: ords) {
+            ++counts[ord];
+        }
+        const auto table = _makeTable(counts);
+        _putTable(table, out);
+
+        // Dense arrays for the coding loop.
+        const auto tableCodes = _makeCodes(table);
+        auto codes = std::vector<std::uint32_t>(counts.size());
+        auto lengths = std::vector<std::uint8_t>(counts.size());
+        for (std::size_t i = 0; i < table.symbols.size(); ++i) {
+            codes[table.symbols[i]] = tableCodes[i];
+            lengths[table.symbols[i]] = table.lengths[i];
+        }
+
+        out.reserve(out.size() + ords.size() * sizeof(OrdT));
+        auto writer = _BitsWriter(out);
+        for (const auto ord: ords) {
+            writer.put(codes[ord], lengths[ord]);
+            tick();
+        }
+        writer.finish();
+        return {ords.size(), out.size() - startSize};
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void HuffmanCoder::decode(std::span<const std::byte> data,
+                          auto outIter,
+                          std::uint64_t wordsCount,
+                          auto tick) {
+    std::size_t pos = 0;
+    const auto decoder = _makeDecoder(_takeTable(data, pos));
+    auto reader = _BitsReader(data, pos);
+
+    std::uint64_t i = 0;
+    while (i + 1 < wordsCount) {
+        const auto window = reader.peek();
+        const auto& entry = decoder.entries[window >> (64 - lookupBits)];
+        if (entry.count == 0) {
+            std::uint8_t bits = 0;
+            *outIter++ = _decodeLong(decoder, window, bits);
+            reader.skip(bits);
+            ++i;
+            tick();
+            continue;
+        }
+        *outIter++ = entry.symbols[0];
+        tick();
+        if (entry.count == 2) {
+            *outIter++ = entry.symbols[1];
+            tick();
+        }
+        reader.skip(entry.bits);
+        i += entry.count;
+    }
+    if (i < wordsCount) {
+        const auto window = reader.peek();
+        const auto& entry = decoder.entries[window >> (64 - lookupBits)];
+        std::uint8_t bits = entry.firstBits;
+        *outIter++ = entry.count == 0
+            ? _decodeLong(decoder, window, bits)
+            : entry.symbols[0];
+        tick();
+    }
+}
+
+#endif  // APPLIB_HUFFMAN_CODER_HPP
@@ -1,11 +1,13 @@
 #ifndef APPLIB_ORD_AND_TAIL_SPLITTER
 #define APPLIB_ORD_AND_TAIL_SPLITTER
 
-#include <algorithm>
 #include <vector>
 #include <cstdint>
 #include <span>
+#include <utility>
 #include <boost/container/static_vector.hpp>
+#include <applib/bits_unpacker.hpp>
+#include <applib/bytes_unpacker.hpp>
 #include <applib/words_and_flow.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -14,8 +16,10 @@
 class OrdAndTailSplitter {
 public:
     struct Ret {
-        std::vector<std::uint64_t> ords;
-        boost::container::static_vector<bool, 32> tail;
+        using Tail = boost::container::static_vector<bool, 32>;
+
+        WordsOrds ords;  // Narrowest ord type for numBits.
+        Tail tail;
     };
 
 public:
@@ -32,16 +36,15 @@ template <std::uint8_t bitsNum>
 auto OrdAndTailSplitter::_process(
         const std::span<const std::byte>& inData) -> Ret {
     auto flow = Flow<bitsNum>(inData);
-    std::vector<std::uint64_t> retOrds;
-    auto outIter = std::back_inserter(retOrds);
-    std::transform(flow.begin(), flow.end(), outIter,
-                   [](const Word<bitsNum>& w) {
-                       return Word<bitsNum>::ord(w);
-                   });
+    auto retOrds = std::vector<WordOrd<bitsNum>>(flow.size());
+    if constexpr (bitsNum % 8 != 0) {
+        BitsUnpacker::unpack(inData, bitsNum, std::span(retOrds));
+    } else {
+        BytesUnpacker::unpack(inData, bitsNum / 8, std::span(retOrds));
+    }
     auto flowTail = flow.getTail();
-    auto retTail = boost::container::static_vector<bool, 32>(
-                flowTail.begin(), flowTail.end());
-    return { retOrds, retTail };
+    auto retTail = Ret::Tail(flowTail.begin(), flowTail.end());
+    return { std::move(retOrds), std::move(retTail) };
 }
 
 #endif  // APPLIB_ORD_AND_TAIL_SPLITTER
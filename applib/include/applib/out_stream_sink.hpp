@@ -0,0 +1,97 @@
+#ifndef APPLIB_OUT_STREAM_SINK_HPP
+#define APPLIB_OUT_STREAM_SINK_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include <ael/byte_data_constructor.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The OutStreamSink class. Writes finished pieces of output data to
+/// the stream on a separate thread, so writing overlaps with coding. Number
+/// of pieces waiting to be written is limited, so memory is bounded.
+///
+class OutStreamSink {
+public:
+
+    constexpr static std::size_t defaultMaxPending = 4;
+
+public:
+
+    /**
+     * @brief OutStreamSink - sink constructor.
+     * @param out - stream to write to.
+     * @param maxPending - max number of pieces waiting to be written.
+     */
+    explicit OutStreamSink(std::ostream& out,
+                           std::size_t maxPending = defaultMaxPending);
+
+    OutStreamSink(const OutStreamSink&) = delete;
+
+    OutStreamSink& operator=(const OutStreamSink&) = delete;
+
+    /**
+     * Waits for all pieces to be written. Errors are ignored, call finish()
+     * to get them.
+     */
+    ~OutStreamSink();
+
+    /**
+     * @brief put - give piece of data to write. Blocks if too many pieces
+     * are waiting.
+     * @param data - data to write.
+     */
+    void put(ael::ByteDataConstructor&& data);
+
+    /**
+     * @brief put - give piece of bytes to write. Blocks if too many pieces
+     * are waiting.
+     * @param data - data to write.
+     */
+    void put(std::vector<std::byte>&& data);
+
+    /**
+     * @brief finish - wait until all pieces are written and flush stream.
+     * Rethrows write error if there was one.
+     */
+    void finish();
+
+    /**
+     * @brief getBytesCount - get number of bytes given to the sink.
+     * @return bytes count.
+     */
+    std::size_t getBytesCount() const { return _bytesCount; }
+
+private:
+
+    using _Piece = std::variant<ael::ByteDataConstructor,
+                                std::vector<std::byte>>;
+
+private:
+
+    void _put(_Piece&& piece, std::size_t size);
+
+    void _writeLoop();
+
+    void _stop();
+
+private:
+    std::ostream& _out;
+    const std::size_t _maxPending;
+    std::size_t _bytesCount{0};
+    std::deque<_Piece> _pending;
+    std::mutex _mutex;
+    std::condition_variable _pendingChanged;
+    std::exception_ptr _error;
+    bool _stopped{false};
+    std::thread _writer;
+};
+
+#endif  // APPLIB_OUT_STREAM_SINK_HPP
@@ -0,0 +1,55 @@
+#ifndef APPLIB_PERF_COUNTERS_HPP
+#define APPLIB_PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The PerfCounters class. Hardware counters of the calling thread
+/// (perf_event_open, user space only). Counters are opened on the first read
+/// in each thread and closed when the thread exits. A counter which can not
+/// be opened (no Linux, no PMU in a VM, perf_event_paranoid) reads as zero.
+///
+class PerfCounters {
+public:
+
+    enum class Counter : std::size_t {
+        Cycles,
+        Instructions,
+        LlcMisses,
+        BranchMisses,
+        Count
+    };
+
+    constexpr static auto countersCount =
+        static_cast<std::size_t>(Counter::Count);
+
+    using Values = std::array<std::uint64_t, countersCount>;
+
+    using Opened = std::array<bool, countersCount>;
+
+public:
+
+    /**
+     * @brief read - read counters of the calling thread.
+     * @return counters values, scaled if counters were multiplexed.
+     */
+    static Values read();
+
+    /**
+     * @brief getOpened - check which counters could be opened in the
+     * calling thread.
+     * @return true for opened counters.
+     */
+    static Opened getOpened();
+
+    /**
+     * @brief getName - get counter name for reports.
+     * @param counter - counter.
+     * @return counter name.
+     */
+    static const char* getName(Counter counter);
+};
+
+#endif  // APPLIB_PERF_COUNTERS_HPP
@@ -0,0 +1,86 @@
+#ifndef APPLIB_PROGRESS_METER_HPP
+#define APPLIB_PROGRESS_METER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+
+#include <indicators/progress_bar.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The ProgressMeter class. Progress bar with throughput and ETA for
+/// per word callbacks. Tick only increments a counter, the clock is checked
+/// every checkStep ticks and the bar is redrawn at most every drawInterval.
+/// Nothing is checked or drawn if log stream is off.
+///
+class ProgressMeter {
+public:
+
+    constexpr static std::uint64_t checkStep = std::uint64_t{1} << 14;
+    constexpr static auto drawInterval = std::chrono::milliseconds(100);
+
+public:
+
+    /**
+     * @brief ProgressMeter - meter constructor.
+     * @param optLogOutStream - stream to draw bar to.
+     * @param label - text before throughput.
+     * @param maxProgress - number of ticks when finished.
+     * @param bytesPerTick - bytes of input per tick. Throughput is not shown
+     * if it is 0.
+     */
+    ProgressMeter(std::ostream& optLogOutStream,
+                  std::string label,
+                  std::uint64_t maxProgress,
+                  double bytesPerTick);
+
+    ProgressMeter(const ProgressMeter&) = delete;
+
+    ProgressMeter& operator=(const ProgressMeter&) = delete;
+
+    /**
+     * @brief getTick - get callback for coders.
+     * @return callback to call once per word.
+     */
+    auto getTick() {
+        return [this] {
+            if (++_progress == _nextCheck) {
+                _check();
+            }
+        };
+    }
+
+    /**
+     * @brief set - set progress, for coding finished out of callbacks.
+     * @param progress - number of ticks done.
+     */
+    void set(std::uint64_t progress);
+
+    /**
+     * @brief finish - draw final state of the bar.
+     */
+    void finish();
+
+private:
+
+    void _check();
+
+    void _draw();
+
+private:
+    using _Clock = std::chrono::steady_clock;
+
+    const std::string _label;
+    const std::uint64_t _maxProgress;
+    const double _bytesPerTick;
+    const bool _quiet;
+    std::uint64_t _progress{0};
+    std::uint64_t _nextCheck{std::numeric_limits<std::uint64_t>::max()};
+    _Clock::time_point _start;
+    _Clock::time_point _lastDraw;
+    indicators::ProgressBar _bar;
+};
+
+#endif  // APPLIB_PROGRESS_METER_HPP
@@ -0,0 +1,346 @@
+#ifndef APPLIB_RANGE_CODER_HPP
+#define APPLIB_RANGE_CODER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The RangeCoder class. Range coder with 64-bit state which is
+/// renormalized by bytes, an alternative to the bit-wise ael arithmetic coder.
+/// It takes the same dictionaries: the coder asks
+/// dict.getProbabilityStats(ord) for [low, high) of the word among total
+/// (the dictionary updates its model there), the decoder also asks
+/// dict.getTotalWordsCnt() and dict.getWordOrd(cumulativeCount).
+///
+/// Range is kept not less than 2^56, so totals of dictionaries must not be
+/// greater than it, otherwise coding throws std::runtime_error. Carries are
+/// propagated to the bytes already coded through a cached byte and a count of
+/// pending 0xFF bytes.
+///
+/// Words may be coded by 2, 4 or 8 interleaved states, word i by state
+/// i % statesCount, so the processor overlaps their dependency chains. States
+/// share one byte stream: the encoder reserves a byte at the moment the
+/// decoder reads it and fills it when the state outputs that byte.
+///
+class RangeCoder {
+public:
+
+    struct EncodeRet {
+        std::uint64_t wordsCount;
+        std::uint64_t bytesCount;
+    };
+
+    constexpr static std::uint64_t minRange = std::uint64_t{1} << 56;
+    constexpr static std::size_t maxStatesCount = 8;
+
+public:
+
+    /**
+     * @brief encode - encode words ords.
+     * @param ords - ords range.
+     * @param out - bytes vector to append encoded bytes to.
+     * @param dict - dictionary.
+     * @param tick - called after each word.
+     * @param statesCount - interleaved states count: 1, 2, 4 or 8.
+     * @return words and encoded bytes counts.
+     */
+    static EncodeRet encode(const auto& ords,
+                            std::vector<std::byte>& out,
+                            auto& dict,
+                            auto tick,
+                            std::size_t statesCount = 1);
+
+    /**
+     * @brief decode - decode words ords.
+     * @param data - encoded bytes.
+     * @param dict - dictionary, in the same state as the coder one.
+     * @param outIter - ords output iterator.
+     * @param wordsCount - count of words to decode.
+     * @param tick - called after each word.
+     * @param statesCount - interleaved states count of the coder.
+     */
+    static void decode(std::span<const std::byte> data,
+                       auto& dict,
+                       auto outIter,
+                       std::uint64_t wordsCount,
+                       auto tick,
+                       std::size_t statesCount = 1);
+
+    /**
+     * @brief isStatesCount - check interleaved states count.
+     * @param statesCount - states count.
+     * @return true if it is 1, 2, 4 or 8.
+     */
+    constexpr static bool isStatesCount(std::size_t statesCount) {
+        return statesCount == 1 || statesCount == 2 || statesCount == 4
+            || statesCount == 8;
+    }
+
+private:
+
+    class _Encoder;
+    class _Decoder;
+
+private:
+
+    static void _checkStats(std::uint64_t low,
+                            std::uint64_t high,
+                            std::uint64_t total) {
+        // Dictionaries are not limited by the range coder precision.
+        if (low >= high || high > total || total > minRange) {
+            throw std::runtime_error("Dictionary probability stats are out "
+                                     "of range coder precision.");
+        }
+    }
+
+    static void _withStatesCount(std::size_t statesCount, auto call);
+
+    template <std::size_t statesCount>
+    static EncodeRet _encode(const auto& ords,
+                             std::vector<std::byte>& out,
+                             auto& dict,
+                             auto tick);
+
+    template <std::size_t statesCount>
+    static void _decode(std::span<const std::byte> data,
+                        auto& dict,
+                        auto outIter,
+                        std::uint64_t wordsCount,
+                        auto tick);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The RangeCoder::_Encoder class. Encoder state. An interleaved
+/// state writes its bytes to the slots it reserved in the shared output.
+///
+class RangeCoder::_Encoder {
+public:
+
+    _Encoder(std::vector<std::byte>& out, bool interleaved)
+        : _out(out), _interleaved(interleaved) {
+        // The decoder starts by reading the whole code.
+        for (std::size_t i = 0; i < sizeof(_low); ++i) {
+            _reserve();
+        }
+    }
+
+    void put(std::uint64_t low, std::uint64_t high, std::uint64_t total) {
+        _checkStats(low, high, total);
+        const auto r = _range / total;
+        const auto newLow = _low + r * low;
+        _carry = _carry || newLow < _low;
+        _low = newLow;
+        // The last word takes the rest of the range lost in division.
+        _range = high < total ? r * (high - low) : _range - r * low;
+        while (_range < minRange) {
+            _reserve();
+            _shiftLow();
+            _range <<= 8;
+        }
+    }
+
+    void finish() {
+        for (std::size_t i = 0; i < sizeof(_low) + 1; ++i) {
+            _shiftLow();
+        }
+    }
+
+private:
+
+    void _reserve() {
+        if (_interleaved) {
+            _slots.push_back(_out.size());
+            _out.emplace_back();
+        }
+    }
+
+    void _emit(std::uint8_t byte) {
+        if (_interleaved) {
+            _out[_slots.front()] = static_cast<std::byte>(byte);
+            _slots.pop_front();
+        } else {
+            _out.push_back(static_cast<std::byte>(byte));
+        }
+    }
+
+    void _shiftLow() {
+        const auto top = static_cast<std::uint8_t>(_low >> 56);
+        if (top != 0xFF || _carry) {
+            const auto carry = static_cast<std::uint8_t>(_carry);
+            // The first cached byte is a zero above the coded value.
+            if (_started) {
+                _emit(static_cast<std::uint8_t>(_cache + carry));
+            }
+            _started = true;
+            for (; _pendingCount != 0; --_pendingCount) {
+                _emit(static_cast<std::uint8_t>(0xFF + carry));
+            }
+            _cache = top;
+            _carry = false;
+        } else {
+            ++_pendingCount;
+        }
+        _low <<= 8;
+    }
+
+private:
+    std::vector<std::byte>& _out;
+    bool _interleaved;
+    std::deque<std::size_t> _slots;
+    std::uint64_t _low{0};
+    std::uint64_t _range{~std::uint64_t{0}};
+    bool _carry{false};
+    bool _started{false};
+    std::uint8_t _cache{0};
+    std::uint64_t _pendingCount{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The RangeCoder::_Decoder class. Decoder state. Interleaved states
+/// read from one position in data. Bytes after the end of data are zeros.
+///
+class RangeCoder::_Decoder {
+public:
+
+    _Decoder(std::span<const std::byte> data, std::size_t& pos)
+        : _data(data), _pos(&pos) {
+        for (std::size_t i = 0; i < sizeof(_code); ++i) {
+            _code = (_code << 8) | _takeByte();
+        }
+    }
+
+    std::uint64_t getCount(std::uint64_t total) {
+        if (total == 0 || total > minRange) {
+            throw std::runtime_error("Dictionary total is out of range "
+                                     "coder precision.");
+        }
+        _r = _range / total;
+        return std::min(_code / _r, total - 1);
+    }
+
+    void take(std::uint64_t low, std::uint64_t high, std::uint64_t total) {
+        _checkStats(low, high, total);
+        _code -= _r * low;
+        _range = high < total ? _r * (high - low) : _range - _r * low;
+        while (_range < minRange) {
+            _code = (_code << 8) | _takeByte();
+            _range <<= 8;
+        }
+    }
+
+private:
+
+    std::uint64_t _takeByte() {
+        if (*_pos == _data.size()) {
+            return 0;
+        }
+        return std::to_integer<std::uint64_t>(_data[(*_pos)++]);
+    }
+
+private:
+    std::span<const std::byte> _data;
+    std::size_t* _pos;
+    std::uint64_t _code{0};
+    std::uint64_t _range{~std::uint64_t{0}};
+    std::uint64_t _r{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+auto RangeCoder::encode(const auto& ords,
+                        std::vector<std::byte>& out,
+                        auto& dict,
+                        auto tick,
+                        std::size_t statesCount) -> EncodeRet {
+    auto ret = EncodeRet();
+    _withStatesCount(statesCount, [&]<std::size_t count>() {
+        ret = _encode<count>(ords, out, dict, tick);
+    });
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RangeCoder::decode(std::span<const std::byte> data,
+                        auto& dict,
+                        auto outIter,
+                        std::uint64_t wordsCount,
+                        auto tick,
+                        std::size_t statesCount) {
+    _withStatesCount(statesCount, [&]<std::size_t count>() {
+        _decode<count>(data, dict, outIter, wordsCount, tick);
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RangeCoder::_withStatesCount(std::size_t statesCount, auto call) {
+    switch (statesCount) {
+    case 1:
+        call.template operator()<1>();
+        break;
+    case 2:
+        call.template operator()<2>();
+        break;
+    case 4:
+        call.template operator()<4>();
+        break;
+    case 8:
+        call.template operator()<8>();
+        break;
+    default:
+        throw std::invalid_argument("Wrong range coder states count.");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <std::size_t statesCount>
+auto RangeCoder::_encode(const auto& ords,
+                         std::vector<std::byte>& out,
+                         auto& dict,
+                         auto tick) -> EncodeRet {
+    const auto startSize = out.size();
+    // States are made in order, as the decoder reads their codes.
+    auto encoders = [&]<std::size_t... i>(std::index_sequence<i...>) {
+        return std::array{((void)i, _Encoder(out, statesCount > 1))...};
+    }(std::make_index_sequence<statesCount>());
+    std::uint64_t wordsCount = 0;
+    for (const auto ord: ords) {
+        const auto [low, high, total] = dict.getProbabilityStats(ord);
+        encoders[wordsCount % statesCount].put(low, high, total);
+        ++wordsCount;
+        tick();
+    }
+    for (auto& encoder: encoders) {
+        encoder.finish();
+    }
+    return {wordsCount, out.size() - startSize};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <std::size_t statesCount>
+void RangeCoder::_decode(std::span<const std::byte> data,
+                         auto& dict,
+                         auto outIter,
+                         std::uint64_t wordsCount,
+                         auto tick) {
+    std::size_t pos = 0;
+    auto decoders = [&]<std::size_t... i>(std::index_sequence<i...>) {
+        return std::array{((void)i, _Decoder(data, pos))...};
+    }(std::make_index_sequence<statesCount>());
+    for (std::uint64_t i = 0; i < wordsCount; ++i) {
+        auto& decoder = decoders[i % statesCount];
+        const auto ord = dict.getWordOrd(
+            decoder.getCount(dict.getTotalWordsCnt()));
+        const auto [low, high, total] = dict.getProbabilityStats(ord);
+        decoder.take(low, high, total);
+        *outIter++ = ord;
+        tick();
+    }
+}
+
+#endif  // APPLIB_RANGE_CODER_HPP
@@ -0,0 +1,210 @@
+#ifndef APPLIB_RANS_CODER_HPP
+#define APPLIB_RANS_CODER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The RansCoder class. Semi-static rANS coder of words up to 16 bits.
+/// Words counts of a frame are normalized to a power of two total and stored
+/// before the coded words. Words are coded by interleaved rANS states with a
+/// single stream of 16-bit renormalization words, so decoding a word is a
+/// table lookup, a multiplication and at most one load.
+///
+/// Frame: | scale bits | symbols count | (symbol, freq - 1) ... | states |
+/// renormalization words |, all numbers are little-endian.
+///
+class RansCoder {
+public:
+
+    struct EncodeRet {
+        std::uint64_t wordsCount;
+        std::uint64_t bytesCount;
+    };
+
+    constexpr static std::uint16_t maxWordBits = 16;
+    constexpr static std::size_t statesCount = 4;
+
+public:
+
+    /**
+     * @brief encode - count words frequencies and encode words ords.
+     * @param ords - ords vector of 8-bit or 16-bit unsigned words.
+     * @param out - bytes vector to append frame to.
+     * @param tick - called after each word.
+     * @return words and frame bytes counts.
+     */
+    static EncodeRet encode(const auto& ords,
+                            std::vector<std::byte>& out,
+                            auto tick);
+
+    /**
+     * @brief decode - decode words ords of a frame.
+     * @param data - frame bytes.
+     * @param outIter - ords output iterator.
+     * @param wordsCount - count of words to decode.
+     * @param tick - called after each word.
+     */
+    static void decode(std::span<const std::byte> data,
+                       auto outIter,
+                       std::uint64_t wordsCount,
+                       auto tick);
+
+private:
+
+    constexpr static std::uint32_t _lowBound = std::uint32_t{1} << 16;
+
+    struct _Table {
+        std::uint8_t scaleBits;
+        std::vector<std::uint16_t> symbols;
+        std::vector<std::uint32_t> freqs;
+    };
+
+    struct _DecodeEntry {
+        std::uint32_t freq;
+        std::uint16_t symbol;
+        std::uint16_t offset;  // Slot minus symbol start.
+    };
+
+    class _WordsReader;
+
+private:
+
+    static _Table _makeTable(std::span<const std::uint32_t> counts);
+
+    static void _putTable(const _Table& table, std::vector<std::byte>& out);
+
+    static _Table _takeTable(std::span<const std::byte> data,
+                             std::size_t& pos);
+
+    static std::vector<_DecodeEntry> _makeDecodeTable(const _Table& table);
+
+    static void _putWords(std::span<const std::uint16_t> reversedWords,
+                          std::vector<std::byte>& out);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The RansCoder::_WordsReader class. Reads 16-bit little-endian
+/// words, zeros after the end of data.
+///
+class RansCoder::_WordsReader {
+public:
+
+    _WordsReader(std::span<const std::byte> data, std::size_t pos)
+        : _data(data), _pos(pos) {}
+
+    std::uint32_t take() {
+        if (_pos + 2 > _data.size()) {
+            return 0;
+        }
+        const auto ret = std::to_integer<std::uint32_t>(_data[_pos])
+            | (std::to_integer<std::uint32_t>(_data[_pos + 1]) << 8);
+        _pos += 2;
+        return ret;
+    }
+
+private:
+    std::span<const std::byte> _data;
+    std::size_t _pos;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+auto RansCoder::encode(const auto& ords,
+                       std::vector<std::byte>& out,
+                       auto tick) -> EncodeRet {
+    using OrdT = std::ranges::range_value_t<decltype(ords)>;
+    if constexpr (sizeof(OrdT) * 8 > maxWordBits) {
+        throw std::invalid_argument("Rans coder words are up to 16 bits.");
+    } else {
+        const auto startSize = out.size();
+        auto counts = std::vector<std::uint32_t>(
+            std::size_t{1} << (8 * sizeof(OrdT)));
+        for (const auto ord: ords) {
+            ++counts[ord];
+        }
+        const auto table = _makeTable(counts);
+        _putTable(table, out);
+
+        // Dense arrays for the coding loop.
+        auto freqs = std::vector<std::uint32_t>(counts.size());
+        auto starts = std::vector<std::uint32_t>(counts.size());
+        std::uint32_t start = 0;
+        for (std::size_t i = 0; i < table.symbols.size(); ++i) {
+            freqs[table.symbols[i]] = table.freqs[i];
+            starts[table.symbols[i]] = start;
+            start += table.freqs[i];
+        }
+
+        // Words are coded from the last one, so the decoder goes forward.
+        const auto scaleBits = table.scaleBits;
+        const auto maxShift = std::uint64_t{_lowBound >> scaleBits} << 16;
+        auto states = std::array<std::uint32_t, statesCount>();
+        states.fill(_lowBound);
+        auto words = std::vector<std::uint16_t>();
+        words.reserve(ords.size() / 2 + 2 * statesCount);
+        for (std::size_t i = ords.size(); i-- != 0;) {
+            auto& state = states[i % statesCount];
+            const auto freq = freqs[ords[i]];
+            if (state >= maxShift * freq) {
+                words.push_back(static_cast<std::uint16_t>(state));
+                state >>= 16;
+            }
+            state = ((state / freq) << scaleBits) + state % freq
+                + starts[ords[i]];
+            tick();
+        }
+        for (std::size_t i = statesCount; i-- != 0;) {
+            words.push_back(static_cast<std::uint16_t>(states[i]));
+            words.push_back(static_cast<std::uint16_t>(states[i] >> 16));
+        }
+        _putWords(words, out);
+        return {ords.size(), out.size() - startSize};
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RansCoder::decode(std::span<const std::byte> data,
+                       auto outIter,
+                       std::uint64_t wordsCount,
+                       auto tick) {
+    std::size_t pos = 0;
+    const auto table = _takeTable(data, pos);
+    const auto decodeTable = _makeDecodeTable(table);
+    const auto scaleBits = table.scaleBits;
+    const auto mask = (std::uint32_t{1} << scaleBits) - 1;
+
+    auto reader = _WordsReader(data, pos);
+    auto states = std::array<std::uint32_t, statesCount>();
+    for (auto& state: states) {
+        state = reader.take() << 16;
+        state |= reader.take();
+    }
+
+    const auto decodeOne = [&](std::uint32_t& state) {
+        const auto& entry = decodeTable[state & mask];
+        state = entry.freq * (state >> scaleBits) + entry.offset;
+        if (state < _lowBound) {
+            state = (state << 16) | reader.take();
+        }
+        *outIter++ = entry.symbol;
+        tick();
+    };
+
+    std::uint64_t i = 0;
+    for (; i + statesCount <= wordsCount; i += statesCount) {
+        decodeOne(states[0]);
+        decodeOne(states[1]);
+        decodeOne(states[2]);
+        decodeOne(states[3]);
+    }
+    for (; i < wordsCount; ++i) {
+        decodeOne(states[i % statesCount]);
+    }
+}
+
+#endif  // APPLIB_RANS_CODER_HPP
@@ -0,0 +1,178 @@
+#ifndef APPLIB_SEMI_STATIC_IMPL_HPP
+#define APPLIB_SEMI_STATIC_IMPL_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <fmt/format.h>
+
+#include <ael/byte_data_constructor.hpp>
+
+#include "batch_impl.hpp"
+#include "decode_impl.hpp"
+#include "encode_impl.hpp"
+#include "file_opener.hpp"
+#include "frames_layout.hpp"
+#include "log_stream_get.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The SemiStaticImpl class. Encoder and decoder of archievers with a
+/// semi-static frame coder, such as RansCoder or HuffmanCoder: each frame
+/// keeps its own table and there are no dictionaries. The coder class takes
+/// words up to CoderT::maxWordBits and has static encode(ords, bytes, tick)
+/// and decode(frameData, ordsOut, wordsCount, tick).
+///
+struct SemiStaticImpl {
+
+    /**
+     * @brief encode - encoder main.
+     * @param argc - arguments count.
+     * @param argv - arguments.
+     * @param coder - coder put to the frames layout.
+     * @return exit code.
+     */
+    template <class CoderT>
+    static int encode(int argc, char* argv[], FramesLayout::Coder coder);
+
+    /**
+     * @brief decode - decoder main.
+     * @param argc - arguments count.
+     * @param argv - arguments.
+     * @param coder - coder the data must be coded with.
+     * @return exit code.
+     */
+    template <class CoderT>
+    static int decode(int argc, char* argv[], FramesLayout::Coder coder);
+
+private:
+
+    static std::string _getName(FramesLayout::Coder coder) {
+        auto ret = std::ostringstream();
+        ret << coder;
+        return ret.str();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+template <class CoderT>
+int SemiStaticImpl::encode(int argc, char* argv[], FramesLayout::Coder coder) {
+    namespace bpo = boost::program_options;
+
+    bpo::options_description appOptionsDescr("Console options.");
+
+    BatchImpl::Options batchOptions;
+    std::uint16_t numBits;
+    EncodeImpl::Options encodeOptions;
+    std::string logStreamParam;
+
+    try {
+        appOptionsDescr.add_options() (
+                "bits,b",
+                bpo::value(&numBits)->default_value(8),
+                "Word bits count, from 8 to 16."
+            ) (
+                "log-stream,l",
+                bpo::value(&logStreamParam)->default_value("stdout"),
+                "Log stream."
+            );
+
+        BatchImpl::addOptions(appOptionsDescr, batchOptions);
+        EncodeImpl::addFramesOptions(appOptionsDescr, encodeOptions);
+
+        bpo::variables_map vm;
+        BatchImpl::store(argc, argv, appOptionsDescr, vm);
+        bpo::notify(vm);
+
+        if (numBits < 8 || numBits > CoderT::maxWordBits) {
+            throw std::runtime_error(fmt::format(
+                "The {} coder takes words of 8 to {} bits.", _getName(coder),
+                CoderT::maxWordBits));
+        }
+        encodeOptions.coder = coder;
+
+        auto& outStream = LogStreamGet::getLogStream(logStreamParam);
+        const auto jobs = BatchImpl::makeJobs(batchOptions, "-encoded");
+        BatchImpl::run(jobs, batchOptions, outStream,
+                       [&](const BatchImpl::Job& job,
+                           std::ostream& logStream,
+                           Stats& stats) {
+            auto fileOpener = FileOpener(job.inFileName, job.outFileName,
+                                         logStream, stats);
+            // Each frame keeps its own table.
+            const auto makeFrameCoder = [] {
+                return [](const auto& ords,
+                          EncodeImpl::EncodedData& data,
+                          auto tick) {
+                    auto& bytes =
+                        data.template emplace<std::vector<std::byte>>();
+                    auto [wordsCount, bytesCount] =
+                        CoderT::encode(ords, bytes, tick);
+                    return FramesLayout::Frame{wordsCount, bytesCount * 8,
+                                               bytesCount};
+                };
+            };
+
+            auto header = ael::ByteDataConstructor();
+            header.putT<std::uint16_t>(numBits);
+            EncodeImpl::processFrames(fileOpener, makeFrameCoder, numBits,
+                                      encodeOptions, std::move(header),
+                                      logStream, stats);
+        });
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        return 2;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class CoderT>
+int SemiStaticImpl::decode(int argc, char* argv[], FramesLayout::Coder coder) {
+    try {
+        auto cfg = DecodeImpl::configure(argc, argv);
+
+        BatchImpl::run(cfg.jobs, cfg.batchOptions, cfg.outStream,
+                       [&](const BatchImpl::Job& job,
+                           std::ostream& logStream,
+                           Stats& stats) {
+            auto file = DecodeImpl::openFile(job, logStream, stats);
+
+            const auto symBitLen = file.decoded.takeT<std::uint16_t>();
+            file.outStream << "Word bits length: " << symBitLen << std::endl;
+
+            const auto makeFrameDecoder = [coder](const FramesLayout& layout) {
+                if (layout.coder != coder) {
+                    throw std::runtime_error(fmt::format(
+                        "Data is not coded with the {} coder.",
+                        _getName(coder)));
+                }
+                return [](std::span<const std::byte> frameData,
+                          const FramesLayout::Frame& frame,
+                          auto ordsOut,
+                          auto tick) {
+                    CoderT::decode(frameData, ordsOut, frame.wordsCount,
+                                   tick);
+                };
+            };
+
+            DecodeImpl::processFrames(file.fileOpener.getInData(),
+                                      makeFrameDecoder, symBitLen,
+                                      cfg.options, file.fileOpener,
+                                      file.outStream, stats);
+        });
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what();
+        return 1;
+    }
+
+    return 0;
+}
+
+#endif  // APPLIB_SEMI_STATIC_IMPL_HPP
@@ -0,0 +1,163 @@
+#ifndef APPLIB_STATS_HPP
+#define APPLIB_STATS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "perf_counters.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The Stats class. Wall and CPU time of encode and decode phases and
+/// counters of one file, written as one JSON line by --stats. Phases may be
+/// timed from many threads at once, so times of a phase add up over threads.
+/// With --perf-counters hardware counters of the phases are added too.
+///
+/// Memory is measured for the process, so it is written only if the file is
+/// the only one processed, and is null otherwise.
+///
+class Stats {
+public:
+
+    enum class Phase : std::size_t {
+        Read,   // Input file open and read, mapped pages are read by Split.
+        Split,  // Input bytes to words ords.
+        Code,   // Arithmetic coding with dictionary update.
+        Pack,   // Decoded ords to output bytes.
+        Write,  // Waiting for output to be written.
+        Count
+    };
+
+    /// \brief The Timer class. Adds time from construction to destruction to
+    /// the phase.
+    class Timer {
+    public:
+        Timer(Stats& stats, Phase phase);
+
+        Timer(const Timer&) = delete;
+
+        Timer& operator=(const Timer&) = delete;
+
+        ~Timer();
+
+    private:
+        Stats& _stats;
+        const Phase _phase;
+        const std::chrono::steady_clock::time_point _wallStart;
+        const std::uint64_t _cpuStart;
+        const PerfCounters::Values _countersStart;
+    };
+
+public:
+
+    /**
+     * @brief Stats - stats constructor.
+     * @param enabled - if stats are going to be written.
+     * @param perfCounters - if hardware counters are collected.
+     * @param exclusive - if no other file is processed by the process.
+     */
+    explicit Stats(bool enabled = false,
+                   bool perfCounters = false,
+                   bool exclusive = true);
+
+    /**
+     * @brief isEnabled - check if stats are going to be written.
+     * @return true if stats are on.
+     */
+    bool isEnabled() const { return _enabled; }
+
+    /**
+     * @brief time - start timing of the phase.
+     * @param phase - phase to add time to.
+     * @return timer to stop by destruction.
+     */
+    Timer time(Phase phase) { return Timer(*this, phase); }
+
+    /**
+     * @brief addBytesIn - count input bytes.
+     * @param count - bytes count.
+     */
+    void addBytesIn(std::uint64_t count) { _bytesIn += count; }
+
+    /**
+     * @brief addBytesOut - count output bytes.
+     * @param count - bytes count.
+     */
+    void addBytesOut(std::uint64_t count) { _bytesOut += count; }
+
+    /**
+     * @brief addWords - count coded words.
+     * @param count - words count.
+     */
+    void addWords(std::uint64_t count) { _words += count; }
+
+    /**
+     * @brief setBitsPerWord - set word length.
+     * @param bitsPerWord - word bits count.
+     */
+    void setBitsPerWord(std::uint16_t bitsPerWord) {
+        _bitsPerWord = bitsPerWord;
+    }
+
+    /**
+     * @brief measureDict - make a dictionary to count heap memory it takes.
+     * Nothing is made if stats are off or other files are processed.
+     * @param makeDict - dictionary maker.
+     */
+    void measureDict(auto makeDict) {
+        if (!_enabled || !_exclusive) {
+            return;
+        }
+        const auto heapBefore = _getHeapInUse();
+        const auto dict = makeDict();
+        const auto heapAfter = _getHeapInUse();
+        _dictBytes = heapAfter > heapBefore ? heapAfter - heapBefore : 0;
+    }
+
+    /**
+     * @brief writeJson - write stats as one JSON line. CPU time of the file
+     * is the sum of CPU times of its phases.
+     * @param inFileName - input file name.
+     * @param outFileName - output file name.
+     * @param wallSeconds - whole file processing wall time.
+     * @param out - stream to write to.
+     */
+    void writeJson(const std::string& inFileName,
+                   const std::string& outFileName,
+                   double wallSeconds,
+                   std::ostream& out) const;
+
+private:
+
+    std::string _countersToJson(std::size_t phase) const;
+
+    static std::uint64_t _getThreadCpuNs();
+
+    static std::uint64_t _getHeapInUse();
+
+    static std::uint64_t _getMaxRssKb();
+
+private:
+    constexpr static auto _phasesCount = static_cast<std::size_t>(Phase::Count);
+
+    const bool _enabled;
+    const bool _perfCounters;
+    const bool _exclusive;
+    const PerfCounters::Opened _countersOpened;
+    std::array<std::atomic<std::uint64_t>, _phasesCount> _wallNs{};
+    std::array<std::atomic<std::uint64_t>, _phasesCount> _cpuNs{};
+    std::array<std::array<std::atomic<std::uint64_t>,
+                          PerfCounters::countersCount>,
+               _phasesCount> _counters{};
+    std::atomic<std::uint64_t> _bytesIn{0};
+    std::atomic<std::uint64_t> _bytesOut{0};
+    std::atomic<std::uint64_t> _words{0};
+    std::uint16_t _bitsPerWord{0};
+    std::uint64_t _dictBytes{0};
+};
+
+#endif  // APPLIB_STATS_HPP
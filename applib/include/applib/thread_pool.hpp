@@ -0,0 +1,81 @@
+#ifndef APPLIB_THREAD_POOL_HPP
+#define APPLIB_THREAD_POOL_HPP
+
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The ThreadPool class. Fixed number of workers taking tasks from
+/// one queue in order of submission.
+///
+class ThreadPool {
+public:
+
+    /**
+     * @brief ThreadPool - pool constructor.
+     * @param threadsCount - number of worker threads, at least one is created.
+     */
+    explicit ThreadPool(std::size_t threadsCount);
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Finishes all submitted tasks and joins workers.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief submit - add task to the queue.
+     * @param task - task to run.
+     * @return future of task result.
+     */
+    template <std::invocable TaskT>
+    std::future<std::invoke_result_t<TaskT>> submit(TaskT&& task);
+
+    /**
+     * @brief size - get number of workers.
+     * @return workers count.
+     */
+    std::size_t size() const { return _workers.size(); }
+
+private:
+
+    void _workLoop();
+
+private:
+    std::deque<std::function<void()>> _tasks;
+    std::mutex _mutex;
+    std::condition_variable _tasksChanged;
+    bool _stopped{false};
+    std::vector<std::thread> _workers;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+template <std::invocable TaskT>
+auto ThreadPool::submit(
+        TaskT&& task) -> std::future<std::invoke_result_t<TaskT>> {
+    using Ret = std::invoke_result_t<TaskT>;
+    // std::function needs copyable callable, packaged task is move-only.
+    auto packagedTask = std::make_shared<std::packaged_task<Ret()>>(
+        std::forward<TaskT>(task));
+    auto ret = packagedTask->get_future();
+    {
+        auto lock = std::lock_guard(_mutex);
+        _tasks.emplace_back([packagedTask]{ (*packagedTask)(); });
+    }
+    _tasksChanged.notify_one();
+    return ret;
+}
+
+#endif  // APPLIB_THREAD_POOL_HPP
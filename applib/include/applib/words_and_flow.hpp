@@ -2,6 +2,9 @@
 #define APPLIB_WORDS_AND_FLOW_HPP
 
 #include <cstdint>
+#include <type_traits>
+#include <variant>
+#include <vector>
 
 #include <applib/word/bytes_word.hpp>
 #include <applib/word/bits_word.hpp>
@@ -31,4 +34,37 @@ using Flow = typename TypeChoise<numBits>::Flow;
 template <std::uint16_t numBits>
 using Word = typename TypeChoise<numBits>::Word;
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+template <std::uint16_t numBits>
+using WordOrd =
+    std::conditional_t<(numBits <= 8), std::uint8_t,
+    std::conditional_t<(numBits <= 16), std::uint16_t,
+    std::conditional_t<(numBits <= 32), std::uint32_t, std::uint64_t>>>;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+using WordsOrds = std::variant<std::vector<std::uint8_t>,
+                               std::vector<std::uint16_t>,
+                               std::vector<std::uint32_t>,
+                               std::vector<std::uint64_t>>;
+
+//----------------------------------------------------------------------------//
+/**
+ * @brief makeWordsOrds - make empty ords vector of the narrowest type which
+ * holds ords of numBits bits words.
+ * @param numBits - word bits count.
+ * @return empty ords vector.
+ */
+inline WordsOrds makeWordsOrds(std::uint16_t numBits) {
+    if (numBits <= 8) {
+        return std::vector<std::uint8_t>();
+    }
+    if (numBits <= 16) {
+        return std::vector<std::uint16_t>();
+    }
+    if (numBits <= 32) {
+        return std::vector<std::uint32_t>();
+    }
+    return std::vector<std::uint64_t>();
+}
+
 #endif  // APPLIB_WORDS_AND_FLOW_HPP
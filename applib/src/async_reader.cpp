@@ -0,0 +1,544 @@
+#include <applib/async_reader.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#if __has_include(<linux/io_uring.h>) && __has_include(<sys/syscall.h>)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define APPLIB_HAS_IO_URING
+#endif
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The AsyncReader::_Pool class. Free buffers of chunks. Chunks may
+/// be destroyed in any thread and after the reader.
+///
+class AsyncReader::_Pool {
+public:
+    explicit _Pool(std::size_t bufferSize) : _bufferSize(bufferSize) {}
+
+    _Storage take() {
+        {
+            auto lock = std::lock_guard(_mutex);
+            if (!_free.empty()) {
+                auto ret = std::move(_free.back());
+                _free.pop_back();
+                return ret;
+            }
+        }
+        return _Storage(static_cast<std::byte*>(::operator new[](
+            _bufferSize, std::align_val_t{bufferAlignment})));
+    }
+
+    void put(_Storage storage) {
+        auto lock = std::lock_guard(_mutex);
+        _free.push_back(std::move(storage));
+    }
+
+private:
+    const std::size_t _bufferSize;
+    std::mutex _mutex;
+    std::vector<_Storage> _free;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncReader::_AlignedDelete::operator()(std::byte* data) const {
+    ::operator delete[](data, std::align_val_t{bufferAlignment});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto AsyncReader::Chunk::operator=(Chunk&& other) noexcept -> Chunk& {
+    if (this != &other) {
+        _release();
+        _pool = std::move(other._pool);
+        _storage = std::move(other._storage);
+        _size = std::exchange(other._size, 0);
+    }
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncReader::Chunk::~Chunk() {
+    _release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncReader::Chunk::_release() {
+    if (_pool && _storage) {
+        _pool->put(std::move(_storage));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The AsyncReader::_Impl class. Reading backend.
+///
+class AsyncReader::_Impl {
+public:
+    virtual ~_Impl() = default;
+
+    virtual Chunk next() = 0;
+
+    virtual bool isIoUring() const = 0;
+};
+
+#ifdef APPLIB_HAS_IO_URING
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The AsyncReader::_UringImpl class. Keeps reads of depth chunks
+/// submitted to io_uring. Completions are taken when a chunk is asked for,
+/// a short read is submitted again for the rest of the chunk.
+///
+class AsyncReader::_UringImpl : public AsyncReader::_Impl {
+public:
+    _UringImpl(int fd,
+               std::size_t chunkSize,
+               std::size_t depth,
+               std::shared_ptr<_Pool> pool);
+
+    _UringImpl(const _UringImpl&) = delete;
+
+    _UringImpl& operator=(const _UringImpl&) = delete;
+
+    ~_UringImpl() override;
+
+    Chunk next() override;
+
+    bool isIoUring() const override { return true; }
+
+private:
+
+    struct _Slot {
+        _Storage buffer;
+        std::size_t filled{0};
+        std::uint64_t offset{0};
+        iovec iov{};
+        bool inFlight{false};
+        bool done{false};
+        int error{0};
+    };
+
+private:
+
+    void _startChunk(std::size_t slotIdx);
+
+    void _submit(std::size_t slotIdx);
+
+    void _waitOne();
+
+    void _release();
+
+    void _unmap();
+
+private:
+    const int _fd;
+    const std::size_t _chunkSize;
+    const std::shared_ptr<_Pool> _pool;
+    int _ringFd{-1};
+    void* _sqPtr{MAP_FAILED};
+    std::size_t _sqSize{0};
+    void* _cqPtr{MAP_FAILED};
+    std::size_t _cqSize{0};
+    io_uring_sqe* _sqes{static_cast<io_uring_sqe*>(MAP_FAILED)};
+    std::size_t _sqesSize{0};
+    unsigned* _sqTail{nullptr};
+    unsigned* _sqMask{nullptr};
+    unsigned* _sqArray{nullptr};
+    unsigned* _cqHead{nullptr};
+    unsigned* _cqTail{nullptr};
+    unsigned* _cqMask{nullptr};
+    io_uring_cqe* _cqes{nullptr};
+    std::vector<_Slot> _slots;
+    std::size_t _head{0};
+    std::uint64_t _nextOffset{0};
+    bool _eof{false};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncReader::_UringImpl::_UringImpl(int fd,
+                                    std::size_t chunkSize,
+                                    std::size_t depth,
+                                    std::shared_ptr<_Pool> pool)
+    : _fd(fd), _chunkSize(chunkSize), _pool(std::move(pool)), _slots(depth) {
+    auto params = io_uring_params{};
+    _ringFd = static_cast<int>(::syscall(
+        __NR_io_uring_setup, static_cast<unsigned>(depth), &params));
+    if (_ringFd < 0) {
+        throw std::runtime_error("io_uring is not available.");
+    }
+
+    _sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMap) {
+        _sqSize = _cqSize = std::max(_sqSize, _cqSize);
+    }
+    _sqPtr = ::mmap(nullptr, _sqSize, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQ_RING);
+    _cqPtr = singleMap
+        ? _sqPtr
+        : ::mmap(nullptr, _cqSize, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_CQ_RING);
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    _sqes = static_cast<io_uring_sqe*>(
+        ::mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQES));
+    if (_sqPtr == MAP_FAILED || _cqPtr == MAP_FAILED
+            || _sqes == MAP_FAILED) {
+        _unmap();
+        ::close(_ringFd);
+        throw std::runtime_error("io_uring is not available.");
+    }
+
+    auto* sq = static_cast<char*>(_sqPtr);
+    _sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    _sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    _sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    auto* cq = static_cast<char*>(_cqPtr);
+    _cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    _cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    _cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    try {
+        for (std::size_t i = 0; i < _slots.size(); ++i) {
+            _startChunk(i);
+        }
+    } catch (const std::runtime_error&) {
+        _release();
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncReader::_UringImpl::~_UringImpl() {
+    _release();
+    ::close(_fd);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto AsyncReader::_UringImpl::next() -> Chunk {
+    if (_eof) {
+        return {};
+    }
+    auto& slot = _slots[_head];
+    while (!slot.done) {
+        _waitOne();
+    }
+    if (slot.error != 0) {
+        _eof = true;
+        throw std::runtime_error(fmt::format(
+            "Could not read file: {}.", std::strerror(slot.error)));
+    }
+    auto ret = Chunk(_pool, std::move(slot.buffer), slot.filled);
+    if (slot.filled < _chunkSize) {
+        _eof = true;
+    } else {
+        _startChunk(_head);
+    }
+    _head = (_head + 1) % _slots.size();
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncReader::_UringImpl::_startChunk(std::size_t slotIdx) {
+    auto& slot = _slots[slotIdx];
+    slot.buffer = _pool->take();
+    slot.filled = 0;
+    slot.offset = _nextOffset;
+    slot.done = false;
+    slot.error = 0;
+    _nextOffset += _chunkSize;
+    _submit(slotIdx);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncReader::_UringImpl::_submit(std::size_t slotIdx) {
+    auto& slot = _slots[slotIdx];
+    slot.iov = {slot.buffer.get() + slot.filled, _chunkSize - slot.filled};
+    slot.inFlight = true;
+
+    const unsigned tail = *_sqTail;
+    const unsigned idx = tail & *_sqMask;
+    auto& sqe = _sqes[idx];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = _fd;
+    sqe.addr = reinterpret_cast<std::uint64_t>(&slot.iov);
+    sqe.len = 1;
+    sqe.off = slot.offset + slot.filled;
+    sqe.user_data = slotIdx;
+    _sqArray[idx] = idx;
+    __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    while (::syscall(__NR_io_uring_enter, _ringFd, 1, 0, 0, nullptr, 0) < 0) {
+        if (errno != EINTR && errno != EAGAIN) {
+            slot.inFlight = false;
+            throw std::runtime_error(fmt::format(
+                "Could not submit read: {}.", std::strerror(errno)));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncReader::_UringImpl::_waitOne() {
+    unsigned head = *_cqHead;
+    while (head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE)) {
+        if (::syscall(__NR_io_uring_enter, _ringFd, 0, 1,
+                      IORING_ENTER_GETEVENTS, nullptr, 0) < 0
+                && errno != EINTR) {
+            throw std::runtime_error(fmt::format(
+                "Could not wait for read: {}.", std::strerror(errno)));
+        }
+    }
+    const auto cqe = _cqes[head & *_cqMask];
+    __atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+
+    auto& slot = _slots[cqe.user_data];
+    slot.inFlight = false;
+    if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+        _submit(cqe.user_data);
+    } else if (cqe.res < 0) {
+        slot.done = true;
+        slot.error = -cqe.res;
+    } else if (cqe.res == 0) {
+        slot.done = true;  // End of file.
+    } else {
+        slot.filled += static_cast<std::size_t>(cqe.res);
+        if (slot.filled == _chunkSize) {
+            slot.done = true;
+        } else {
+            _submit(cqe.user_data);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncReader::_UringImpl::_release() {
+    // Kernel may still write to buffers of reads in flight.
+    try {
+        for (const auto& slot: _slots) {
+            while (slot.inFlight) {
+                _waitOne();
+            }
+        }
+    } catch (const std::runtime_error&) {
+        // Ring can not be waited on, nothing else to do.
+    }
+    _unmap();
+    ::close(_ringFd);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncReader::_UringImpl::_unmap() {
+    if (_sqes != MAP_FAILED) {
+        ::munmap(_sqes, _sqesSize);
+    }
+    if (_cqPtr != MAP_FAILED && _cqPtr != _sqPtr) {
+        ::munmap(_cqPtr, _cqSize);
+    }
+    if (_sqPtr != MAP_FAILED) {
+        ::munmap(_sqPtr, _sqSize);
+    }
+}
+
+#endif  // APPLIB_HAS_IO_URING
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The AsyncReader::_ThreadImpl class. Helper thread reads up to depth
+/// chunks ahead.
+///
+class AsyncReader::_ThreadImpl : public AsyncReader::_Impl {
+public:
+    _ThreadImpl(const std::string& fileName,
+                std::size_t chunkSize,
+                std::size_t depth,
+                std::shared_ptr<_Pool> pool);
+
+    _ThreadImpl(const _ThreadImpl&) = delete;
+
+    _ThreadImpl& operator=(const _ThreadImpl&) = delete;
+
+    ~_ThreadImpl() override;
+
+    Chunk next() override;
+
+    bool isIoUring() const override { return false; }
+
+private:
+
+    void _readLoop();
+
+private:
+    std::ifstream _file;
+    std::istream& _in;
+    const std::size_t _chunkSize;
+    const std::size_t _depth;
+    const std::shared_ptr<_Pool> _pool;
+    std::deque<Chunk> _pending;
+    std::mutex _mutex;
+    std::condition_variable _pendingChanged;
+    std::exception_ptr _error;
+    bool _finished{false};
+    bool _stopped{false};
+    std::thread _reader;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncReader::_ThreadImpl::_ThreadImpl(const std::string& fileName,
+                                      std::size_t chunkSize,
+                                      std::size_t depth,
+                                      std::shared_ptr<_Pool> pool)
+    : _in(fileName == "-" ? std::cin : _file),
+      _chunkSize(chunkSize),
+      _depth(depth),
+      _pool(std::move(pool)) {
+    if (fileName != "-") {
+        _file.open(fileName, std::ios::binary);
+        if (!_file.is_open()) {
+            throw std::runtime_error(
+                fmt::format("Could not open file: \"{}\"", fileName));
+        }
+    }
+    _reader = std::thread([this]{ _readLoop(); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncReader::_ThreadImpl::~_ThreadImpl() {
+    {
+        auto lock = std::lock_guard(_mutex);
+        _stopped = true;
+    }
+    _pendingChanged.notify_all();
+    _reader.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto AsyncReader::_ThreadImpl::next() -> Chunk {
+    auto lock = std::unique_lock(_mutex);
+    _pendingChanged.wait(lock, [this]{
+        return !_pending.empty() || _finished || _error;
+    });
+    if (_error) {
+        std::rethrow_exception(_error);
+    }
+    if (_pending.empty()) {
+        return {};
+    }
+    auto ret = std::move(_pending.front());
+    _pending.pop_front();
+    _pendingChanged.notify_all();
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncReader::_ThreadImpl::_readLoop() {
+    // Pipes give data by small pieces, so a chunk is read by blocks.
+    constexpr std::size_t readBlockSize = 1 << 16;
+    while (true) {
+        {
+            auto lock = std::unique_lock(_mutex);
+            _pendingChanged.wait(lock, [this]{
+                return _pending.size() < _depth || _stopped;
+            });
+            if (_stopped) {
+                return;
+            }
+        }
+
+        auto buffer = _pool->take();
+        std::size_t filled = 0;
+        while (_in && filled < _chunkSize) {
+            const auto blockSize = std::min(readBlockSize, _chunkSize - filled);
+            _in.read(reinterpret_cast<char*>(buffer.get() + filled),
+                     static_cast<std::streamsize>(blockSize));
+            filled += static_cast<std::size_t>(_in.gcount());
+        }
+
+        auto lock = std::lock_guard(_mutex);
+        if (_in.bad()) {
+            _error = std::make_exception_ptr(
+                std::runtime_error("Could not read file."));
+            _pendingChanged.notify_all();
+            return;
+        }
+        const bool isLast = filled < _chunkSize;
+        if (filled != 0) {
+            _pending.push_back(Chunk(_pool, std::move(buffer), filled));
+        }
+        _finished = isLast;
+        _pendingChanged.notify_all();
+        if (isLast) {
+            return;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncReader::AsyncReader(const std::string& fileName,
+                         std::size_t chunkSize,
+                         std::size_t depth) {
+    depth = std::max<std::size_t>(depth, 1);
+    auto pool = std::make_shared<_Pool>(chunkSize);
+#ifdef APPLIB_HAS_IO_URING
+    // Reads of regular files at offsets may go at once, pipes are read by
+    // the thread.
+    if (fileName != "-") {
+        const int fd = ::open(fileName.c_str(), O_RDONLY);
+        struct stat fileStat;
+        if (fd >= 0 && ::fstat(fd, &fileStat) == 0
+                && S_ISREG(fileStat.st_mode)) {
+            try {
+                _impl = std::make_unique<_UringImpl>(fd, chunkSize, depth,
+                                                     pool);
+                return;
+            } catch (const std::runtime_error&) {
+                // Falls back to the thread.
+            }
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+#endif
+    _impl = std::make_unique<_ThreadImpl>(fileName, chunkSize, depth,
+                                          std::move(pool));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncReader::AsyncReader(AsyncReader&&) noexcept = default;
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncReader& AsyncReader::operator=(AsyncReader&&) noexcept = default;
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncReader::~AsyncReader() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+auto AsyncReader::next() -> Chunk {
+    return _impl->next();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool AsyncReader::isIoUring() const {
+    return _impl->isIoUring();
+}
@@ -0,0 +1,236 @@
+#include <applib/batch_impl.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+
+#include <boost/program_options.hpp>
+#include <fmt/format.h>
+
+#include <applib/file_opener.hpp>
+#include <applib/thread_pool.hpp>
+
+#if __has_include(<glob.h>)
+#include <glob.h>
+#define APPLIB_HAS_GLOB
+#endif
+
+namespace bpo = boost::program_options;
+namespace fs = std::filesystem;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+void expandGlob(const std::string& pattern, std::vector<std::string>& out) {
+#ifdef APPLIB_HAS_GLOB
+    if (pattern.find_first_of("*?[") != std::string::npos) {
+        glob_t globRet;
+        if (::glob(pattern.c_str(), 0, nullptr, &globRet) == 0) {
+            out.insert(out.end(), globRet.gl_pathv,
+                       globRet.gl_pathv + globRet.gl_pathc);
+            ::globfree(&globRet);
+            return;
+        }
+        ::globfree(&globRet);
+    }
+#endif
+    out.push_back(pattern);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uintmax_t getFileSize(const std::string& fileName) {
+    auto error = std::error_code();
+    const auto ret = fs::file_size(fileName, error);
+    return error ? 0 : ret;
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+void BatchImpl::addOptions(bpo::options_description& descr,
+                           Options& options) {
+    descr.add_options() (
+        "input-file,i",
+        bpo::value(&options.inFileNames)->multitoken(),
+        "In files names or globs, - for standard input. Also taken from "
+        "positional arguments."
+    ) (
+        "manifest",
+        bpo::value(&options.manifestFileName)->default_value({}),
+        "File with in files names, one per line."
+    ) (
+        "out-filename,o",
+        bpo::value(&options.outFileName)->default_value({}),
+        "Out file name, - for standard output. Only for one in file."
+    ) (
+        "out-dir",
+        bpo::value(&options.outDirName)->default_value({}),
+        "Out files directory."
+    ) (
+        "jobs,j",
+        bpo::value(&options.jobsCount)->default_value(1),
+        "Number of files processed at once."
+    ) (
+        "stats",
+        bpo::value(&options.statsParam)->default_value({}),
+        "Per file stats JSON lines output: file name or stderr."
+    ) (
+        "perf-counters",
+        bpo::bool_switch(&options.perfCounters),
+        "Add hardware counters of phases to stats. Stats go to stderr if "
+        "--stats is not set."
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BatchImpl::store(int argc, char* argv[],
+                      const bpo::options_description& descr,
+                      bpo::variables_map& vm) {
+    auto positional = bpo::positional_options_description();
+    positional.add("input-file", -1);
+    bpo::store(bpo::command_line_parser(argc, argv)
+                   .options(descr)
+                   .positional(positional)
+                   .run(),
+               vm);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto BatchImpl::makeJobs(const Options& options,
+                         const std::string& outSuffix) -> std::vector<Job> {
+    auto inFileNames = std::vector<std::string>();
+    for (const auto& name: options.inFileNames) {
+        expandGlob(name, inFileNames);
+    }
+    if (!options.manifestFileName.empty()) {
+        auto manifest = std::ifstream(options.manifestFileName);
+        if (!manifest) {
+            throw std::runtime_error(fmt::format(
+                "Could not open manifest {}.", options.manifestFileName));
+        }
+        for (std::string line; std::getline(manifest, line);) {
+            if (!line.empty()) {
+                inFileNames.push_back(line);
+            }
+        }
+    }
+    if (inFileNames.empty()) {
+        throw std::runtime_error("No in files.");
+    }
+    if (!options.outFileName.empty() && inFileNames.size() != 1) {
+        throw std::runtime_error("Out file name is only for one in file.");
+    }
+    if (!options.outDirName.empty()) {
+        fs::create_directories(options.outDirName);
+    }
+
+    auto ret = std::vector<Job>();
+    auto outPaths = std::set<fs::path>();
+    for (auto& inFileName: inFileNames) {
+        auto outFileName = std::string();
+        if (!options.outFileName.empty()) {
+            outFileName = options.outFileName;
+        } else if (inFileName == FileOpener::stdStreamName) {
+            outFileName = FileOpener::stdStreamName;
+        } else if (!options.outDirName.empty()) {
+            outFileName = (fs::path(options.outDirName)
+                / (fs::path(inFileName).filename().string() + outSuffix))
+                    .string();
+        } else {
+            outFileName = inFileName + outSuffix;
+        }
+        // Same names from different directories would overwrite each other
+        // in out directory.
+        if (outFileName != FileOpener::stdStreamName
+                && !outPaths.insert(fs::path(outFileName).lexically_normal())
+                        .second) {
+            throw std::runtime_error(fmt::format(
+                "Out file {} is repeated.", outFileName));
+        }
+        ret.push_back({std::move(inFileName), std::move(outFileName)});
+    }
+    std::stable_sort(ret.begin(), ret.end(),
+                     [](const Job& left, const Job& right) {
+                         return getFileSize(left.inFileName)
+                             > getFileSize(right.inFileName);
+                     });
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BatchImpl::run(const std::vector<Job>& jobs,
+                    const Options& options,
+                    std::ostream& logStream,
+                    const ProcessFile& processFile) {
+    auto statsFile = std::ofstream();
+    if (!options.statsParam.empty() && options.statsParam != "stderr") {
+        statsFile.open(options.statsParam);
+        if (!statsFile) {
+            throw std::runtime_error(fmt::format(
+                "Could not open stats file {}.", options.statsParam));
+        }
+    }
+    auto& statsStream = statsFile.is_open() ? statsFile : std::cerr;
+    auto statsMutex = std::mutex();
+
+    const auto processWithStats = [&](const Job& job,
+                                      std::ostream& jobLogStream) {
+        // Logs must not get into data written to standard output.
+        auto& fileLogStream =
+            job.outFileName == FileOpener::stdStreamName
+                    && &jobLogStream == &std::cout
+                ? std::cerr
+                : jobLogStream;
+        auto stats = Stats(!options.statsParam.empty() || options.perfCounters,
+                           options.perfCounters, jobs.size() == 1);
+        const auto wallStart = std::chrono::steady_clock::now();
+        processFile(job, fileLogStream, stats);
+        if (stats.isEnabled()) {
+            const auto wallSeconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - wallStart).count();
+            auto lock = std::lock_guard(statsMutex);
+            stats.writeJson(job.inFileName, job.outFileName, wallSeconds,
+                            statsStream);
+        }
+    };
+
+    if (jobs.size() == 1) {
+        processWithStats(jobs.front(), logStream);
+        return;
+    }
+
+    auto logMutex = std::mutex();
+    auto failedCount = std::atomic<std::size_t>(0);
+    {
+        auto pool = ThreadPool(std::min(options.jobsCount, jobs.size()));
+        for (const auto& job: jobs) {
+            pool.submit([&] {
+                try {
+                    // Each job has its own null stream, as streaming sets the
+                    // stream state.
+                    auto nullStream = std::ostream(nullptr);
+                    processWithStats(job, nullStream);
+                    auto lock = std::lock_guard(logMutex);
+                    logStream << job.inFileName << " -> "
+                              << job.outFileName << std::endl;
+                } catch (const std::exception& error) {
+                    ++failedCount;
+                    auto lock = std::lock_guard(logMutex);
+                    std::cerr << job.inFileName << ": " << error.what()
+                              << std::endl;
+                }
+            });
+        }
+    }
+    if (failedCount != 0) {
+        throw std::runtime_error(fmt::format(
+            "{} of {} files failed.", failedCount.load(), jobs.size()));
+    }
+}
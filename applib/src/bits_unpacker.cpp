@@ -0,0 +1,143 @@
+#include <applib/bits_unpacker.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+#include <applib/cpu_features.hpp>
+
+#ifdef APPLIB_HAS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+// 64 bits starting from ptr, first byte is the most significant one.
+std::uint64_t loadBigEndian(const std::byte* ptr) {
+    std::uint64_t ret;
+    std::memcpy(&ret, ptr, sizeof(ret));
+    if constexpr (std::endian::native == std::endian::little) {
+        ret = __builtin_bswap64(ret);
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Same as loadBigEndian, but does not read after the end of data.
+std::uint64_t loadBigEndianSafe(std::span<const std::byte> data,
+                                std::size_t offset) {
+    std::byte buff[sizeof(std::uint64_t)] = {};
+    std::memcpy(buff, data.data() + offset,
+                std::min(sizeof(buff), data.size() - offset));
+    return loadBigEndian(buff);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class OrdT>
+void unpackScalar(std::span<const std::byte> data,
+                  std::uint16_t numBits,
+                  std::span<OrdT> ords,
+                  std::size_t from) {
+    const auto fastEnd = data.size() < sizeof(std::uint64_t)
+        ? 0 : data.size() - sizeof(std::uint64_t);
+    const auto dropped = 64 - numBits;
+    for (std::size_t i = from; i < ords.size(); ++i) {
+        const auto bitPos = i * numBits;
+        const auto byte = bitPos / 8;
+        const auto word = byte <= fastEnd
+            ? loadBigEndian(data.data() + byte)
+            : loadBigEndianSafe(data, byte);
+        ords[i] = static_cast<OrdT>((word << (bitPos % 8)) >> dropped);
+    }
+}
+
+#ifdef APPLIB_HAS_X86_KERNELS
+
+////////////////////////////////////////////////////////////////////////////////
+// Four ords by bits positions. All four loads must be inside of data.
+__attribute__((target("avx2")))
+__m256i unpackFourAvx2(const std::byte* data, __m256i bitPos,
+                       __m128i dropped) {
+    const auto bswapMask = _mm256_setr_epi8(
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const auto bytesPos = _mm256_srli_epi64(bitPos, 3);
+    const auto shifts = _mm256_and_si256(bitPos, _mm256_set1_epi64x(7));
+    auto words = _mm256_i64gather_epi64(
+        reinterpret_cast<const long long*>(data), bytesPos, 1);
+    words = _mm256_shuffle_epi8(words, bswapMask);
+    return _mm256_srl_epi64(_mm256_sllv_epi64(words, shifts), dropped);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns number of unpacked ords, the rest is left for scalar loop.
+template <class OrdT>
+__attribute__((target("avx2")))
+std::size_t unpackAvx2(std::span<const std::byte> data,
+                       std::uint16_t numBits,
+                       std::span<OrdT> ords) {
+    if (data.size() < sizeof(std::uint64_t)) {
+        return 0;
+    }
+    // Last load of eight words starts at byte of word i + 7.
+    const auto loadsEnd = data.size() - sizeof(std::uint64_t);
+    const auto lowHalf = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    const auto dropped = _mm_cvtsi32_si128(64 - numBits);
+    const auto step = _mm256_set1_epi64x(8 * std::int64_t{numBits});
+    auto bitPosLo = _mm256_setr_epi64x(
+        0, numBits, 2 * numBits, 3 * numBits);
+    auto bitPosHi = _mm256_add_epi64(
+        bitPosLo, _mm256_set1_epi64x(4 * std::int64_t{numBits}));
+
+    std::size_t i = 0;
+    for (; i + 8 <= ords.size() && (i + 7) * numBits / 8 <= loadsEnd; i += 8) {
+        const auto lo = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+            unpackFourAvx2(data.data(), bitPosLo, dropped), lowHalf));
+        const auto hi = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+            unpackFourAvx2(data.data(), bitPosHi, dropped), lowHalf));
+        if constexpr (sizeof(OrdT) == sizeof(std::uint16_t)) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(ords.data() + i),
+                             _mm_packus_epi32(lo, hi));
+        } else {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(ords.data() + i), lo);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(ords.data() + i + 4),
+                             hi);
+        }
+        bitPosLo = _mm256_add_epi64(bitPosLo, step);
+        bitPosHi = _mm256_add_epi64(bitPosHi, step);
+    }
+    return i;
+}
+
+#endif  // APPLIB_HAS_X86_KERNELS
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+template <class OrdT>
+void BitsUnpacker::unpack(std::span<const std::byte> data,
+                          std::uint16_t numBits,
+                          std::span<OrdT> ords) {
+    assert(numBits >= 1 && numBits <= 32 && "Unsupported bits count.");
+    assert(numBits <= 8 * sizeof(OrdT) && "Too narrow ord type.");
+    assert(ords.size() * numBits <= data.size() * 8 && "Too many ords.");
+    std::size_t unpacked = 0;
+#ifdef APPLIB_HAS_X86_KERNELS
+    if constexpr (sizeof(OrdT) == sizeof(std::uint16_t)
+                  || sizeof(OrdT) == sizeof(std::uint32_t)) {
+        if (CpuFeatures::hasAvx2()) {
+            unpacked = unpackAvx2(data, numBits, ords);
+        }
+    }
+#endif
+    unpackScalar(data, numBits, ords, unpacked);
+}
+
+template void BitsUnpacker::unpack(std::span<const std::byte>, std::uint16_t,
+                                   std::span<std::uint8_t>);
+template void BitsUnpacker::unpack(std::span<const std::byte>, std::uint16_t,
+                                   std::span<std::uint16_t>);
+template void BitsUnpacker::unpack(std::span<const std::byte>, std::uint16_t,
+                                   std::span<std::uint32_t>);
@@ -0,0 +1,159 @@
+#include <applib/bits_writer.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <applib/cpu_features.hpp>
+
+#ifdef APPLIB_HAS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+
+#ifdef APPLIB_HAS_X86_KERNELS
+
+/*
+ * Shuffle masks for 16 bytes, inverse of BytesUnpacker ones. Three bytes
+ * words give 12 bytes, the last 4 bytes of a store are overwritten by the
+ * next one.
+ */
+#define APPLIB_SWAP2_MASK 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+#define APPLIB_SWAP3_MASK 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, \
+                          -128, -128, -128, -128
+#define APPLIB_SWAP4_MASK 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns number of written ords, the rest is left for scalar loop.
+template <class OrdT>
+__attribute__((target("ssse3")))
+std::size_t packSsse3(std::span<const OrdT> ords,
+                      std::uint8_t numBytes,
+                      std::span<std::byte> out) {
+    constexpr std::size_t storeSize = sizeof(__m128i);
+    const auto mask = numBytes == 2
+        ? _mm_setr_epi8(APPLIB_SWAP2_MASK)
+        : numBytes == 3
+            ? _mm_setr_epi8(APPLIB_SWAP3_MASK)
+            : _mm_setr_epi8(APPLIB_SWAP4_MASK);
+    const std::size_t step = numBytes == 2 ? 8 : 4;
+    std::size_t i = 0;
+    for (; i + step <= ords.size() && i * numBytes + storeSize <= out.size();
+            i += step) {
+        const auto words = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(ords.data() + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i * numBytes),
+                         _mm_shuffle_epi8(words, mask));
+    }
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns number of written ords, the rest is left for scalar loop.
+template <class OrdT>
+__attribute__((target("avx2")))
+std::size_t packAvx2(std::span<const OrdT> ords,
+                     std::uint8_t numBytes,
+                     std::span<std::byte> out) {
+    constexpr std::size_t storeSize = sizeof(__m256i);
+    const auto mask = numBytes == 2
+        ? _mm256_setr_epi8(APPLIB_SWAP2_MASK, APPLIB_SWAP2_MASK)
+        : numBytes == 3
+            ? _mm256_setr_epi8(APPLIB_SWAP3_MASK, APPLIB_SWAP3_MASK)
+            : _mm256_setr_epi8(APPLIB_SWAP4_MASK, APPLIB_SWAP4_MASK);
+    const std::size_t step = numBytes == 2 ? 16 : 8;
+    // Three bytes words: two stores of 16 bytes at offsets 0 and 12.
+    const std::size_t writeSize = numBytes == 3 ? 28 : storeSize;
+    std::size_t i = 0;
+    for (; i + step <= ords.size() && i * numBytes + writeSize <= out.size();
+            i += step) {
+        const auto words = _mm256_shuffle_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+                ords.data() + i)),
+            mask);
+        auto* ptr = out.data() + i * numBytes;
+        if (numBytes == 3) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr),
+                             _mm256_castsi256_si128(words));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr + 12),
+                             _mm256_extracti128_si256(words, 1));
+        } else {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), words);
+        }
+    }
+    return i;
+}
+
+#undef APPLIB_SWAP2_MASK
+#undef APPLIB_SWAP3_MASK
+#undef APPLIB_SWAP4_MASK
+
+#endif  // APPLIB_HAS_X86_KERNELS
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+template <class OrdT>
+void BitsWriter::putOrds(std::span<const OrdT> ords, std::uint16_t numBits) {
+    assert(numBits >= 1 && numBits <= 32 && "Unsupported bits count.");
+    assert(numBits <= 8 * sizeof(OrdT) && "Too narrow ord type.");
+    // Vector stores and the bytes copy do not check the buffer end.
+    const auto freeBits = (_out.size() - _pos) * 8 - _accBits;
+    if (ords.size() > freeBits / numBits) {
+        throw std::runtime_error("Bits writer buffer is too short.");
+    }
+    std::size_t written = 0;
+    if (numBits % 8 == 0 && _accBits % 8 == 0) {
+        _flushBytes();
+        const auto numBytes = static_cast<std::uint8_t>(numBits / 8);
+        const auto rest = _out.subspan(_pos);
+        if constexpr (sizeof(OrdT) == 1) {
+            written = ords.size();
+            std::copy(ords.begin(), ords.end(),
+                      reinterpret_cast<OrdT*>(rest.data()));
+        }
+#ifdef APPLIB_HAS_X86_KERNELS
+        // Shuffles only take ords of the type of the next power of two bytes.
+        const bool shuffled = (numBytes == 2 && sizeof(OrdT) == 2)
+            || ((numBytes == 3 || numBytes == 4) && sizeof(OrdT) == 4);
+        if (shuffled && CpuFeatures::hasAvx2()) {
+            written = packAvx2(ords, numBytes, rest);
+        } else if (shuffled && CpuFeatures::hasSsse3()) {
+            written = packSsse3(ords, numBytes, rest);
+        }
+#endif
+        _pos += written * numBytes;
+    }
+    for (auto ord: ords.subspan(written)) {
+        put(ord, numBits);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t BitsWriter::finish() {
+    const auto bytesCount = (_accBits + 7) / 8;
+    if (bytesCount != 0) {
+        _acc <<= 8 * bytesCount - _accBits;
+        _accBits = 8 * bytesCount;
+        _flushBytes();
+    }
+    return _pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BitsWriter::_flushBytes() {
+    assert(_accBits % 8 == 0 && "Not whole bytes.");
+    assert(_pos + _accBits / 8 <= _out.size() && "Out of buffer.");
+    for (; _accBits != 0; _accBits -= 8) {
+        _out[_pos++] = static_cast<std::byte>(_acc >> (_accBits - 8));
+    }
+}
+
+template void BitsWriter::putOrds(std::span<const std::uint8_t>,
+                                  std::uint16_t);
+template void BitsWriter::putOrds(std::span<const std::uint16_t>,
+                                  std::uint16_t);
+template void BitsWriter::putOrds(std::span<const std::uint32_t>,
+                                  std::uint16_t);
+template void BitsWriter::putOrds(std::span<const std::uint64_t>,
+                                  std::uint16_t);
@@ -0,0 +1,139 @@
+#include <applib/bytes_unpacker.hpp>
+
+#include <cassert>
+
+#include <applib/cpu_features.hpp>
+
+#ifdef APPLIB_HAS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+template <class OrdT>
+void unpackScalar(std::span<const std::byte> data,
+                  std::uint8_t numBytes,
+                  std::span<OrdT> ords,
+                  std::size_t from) {
+    const auto* ptr = data.data() + from * numBytes;
+    for (std::size_t i = from; i < ords.size(); ++i) {
+        std::uint64_t ord = 0;
+        for (std::uint8_t j = 0; j < numBytes; ++j, ++ptr) {
+            ord = (ord << 8) | std::to_integer<std::uint64_t>(*ptr);
+        }
+        ords[i] = static_cast<OrdT>(ord);
+    }
+}
+
+#ifdef APPLIB_HAS_X86_KERNELS
+
+/*
+ * Shuffle masks for 16 bytes. Three bytes words take 12 bytes of 16 loaded,
+ * the high byte of each ord is zeroed.
+ */
+#define APPLIB_SWAP2_MASK 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+#define APPLIB_SWAP3_MASK 2, 1, 0, -128, 5, 4, 3, -128, \
+                          8, 7, 6, -128, 11, 10, 9, -128
+#define APPLIB_SWAP4_MASK 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns number of unpacked ords, the rest is left for scalar loop.
+template <class OrdT>
+__attribute__((target("ssse3")))
+std::size_t unpackSsse3(std::span<const std::byte> data,
+                        std::uint8_t numBytes,
+                        std::span<OrdT> ords) {
+    constexpr std::size_t loadSize = sizeof(__m128i);
+    const auto mask = numBytes == 2
+        ? _mm_setr_epi8(APPLIB_SWAP2_MASK)
+        : numBytes == 3
+            ? _mm_setr_epi8(APPLIB_SWAP3_MASK)
+            : _mm_setr_epi8(APPLIB_SWAP4_MASK);
+    const std::size_t step = numBytes == 2 ? 8 : 4;
+    std::size_t i = 0;
+    for (; i + step <= ords.size() && i * numBytes + loadSize <= data.size();
+            i += step) {
+        const auto bytes = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(data.data() + i * numBytes));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(ords.data() + i),
+                         _mm_shuffle_epi8(bytes, mask));
+    }
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns number of unpacked ords, the rest is left for scalar loop.
+template <class OrdT>
+__attribute__((target("avx2")))
+std::size_t unpackAvx2(std::span<const std::byte> data,
+                       std::uint8_t numBytes,
+                       std::span<OrdT> ords) {
+    constexpr std::size_t loadSize = sizeof(__m256i);
+    const auto mask = numBytes == 2
+        ? _mm256_setr_epi8(APPLIB_SWAP2_MASK, APPLIB_SWAP2_MASK)
+        : numBytes == 3
+            ? _mm256_setr_epi8(APPLIB_SWAP3_MASK, APPLIB_SWAP3_MASK)
+            : _mm256_setr_epi8(APPLIB_SWAP4_MASK, APPLIB_SWAP4_MASK);
+    const std::size_t step = numBytes == 2 ? 16 : 8;
+    // Three bytes words: two halves of 12 bytes, the second one is loaded
+    // from offset 12 and reads 4 bytes more.
+    const std::size_t readSize = numBytes == 3 ? 28 : loadSize;
+    std::size_t i = 0;
+    for (; i + step <= ords.size() && i * numBytes + readSize <= data.size();
+            i += step) {
+        const auto* ptr = data.data() + i * numBytes;
+        auto bytes = __m256i();
+        if (numBytes == 3) {
+            bytes = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + 12)),
+                1);
+        } else {
+            bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ords.data() + i),
+                            _mm256_shuffle_epi8(bytes, mask));
+    }
+    return i;
+}
+
+#undef APPLIB_SWAP2_MASK
+#undef APPLIB_SWAP3_MASK
+#undef APPLIB_SWAP4_MASK
+
+#endif  // APPLIB_HAS_X86_KERNELS
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+template <class OrdT>
+void BytesUnpacker::unpack(std::span<const std::byte> data,
+                           std::uint8_t numBytes,
+                           std::span<OrdT> ords) {
+    assert(numBytes >= 1 && numBytes <= 4 && "Unsupported bytes count.");
+    assert(numBytes <= sizeof(OrdT) && "Too narrow ord type.");
+    assert(ords.size() * numBytes <= data.size() && "Too many ords.");
+    std::size_t unpacked = 0;
+#ifdef APPLIB_HAS_X86_KERNELS
+    // Shuffles only give ords of the type of the next power of two bytes.
+    const bool shuffled = (numBytes == 2 && sizeof(OrdT) == 2)
+        || ((numBytes == 3 || numBytes == 4) && sizeof(OrdT) == 4);
+    if (shuffled && CpuFeatures::hasAvx2()) {
+        unpacked = unpackAvx2(data, numBytes, ords);
+    } else if (shuffled && CpuFeatures::hasSsse3()) {
+        unpacked = unpackSsse3(data, numBytes, ords);
+    }
+#endif
+    unpackScalar(data, numBytes, ords, unpacked);
+}
+
+template void BytesUnpacker::unpack(std::span<const std::byte>, std::uint8_t,
+                                    std::span<std::uint8_t>);
+template void BytesUnpacker::unpack(std::span<const std::byte>, std::uint8_t,
+                                    std::span<std::uint16_t>);
+template void BytesUnpacker::unpack(std::span<const std::byte>, std::uint8_t,
+                                    std::span<std::uint32_t>);
+template void BytesUnpacker::unpack(std::span<const std::byte>, std::uint8_t,
+                                    std::span<std::uint64_t>);
@@ -0,0 +1,27 @@
+#include <applib/cpu_features.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+bool CpuFeatures::hasSsse3() {
+#ifdef APPLIB_HAS_X86_KERNELS
+    static const bool ret = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("ssse3") != 0;
+    }();
+    return ret;
+#else
+    return false;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CpuFeatures::hasAvx2() {
+#ifdef APPLIB_HAS_X86_KERNELS
+    static const bool ret = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return ret;
+#else
+    return false;
+#endif
+}
@@ -1,8 +1,8 @@
 #include <applib/decode_impl.hpp>
 
-#include <ael/byte_data_constructor.hpp>
 #include <ael/data_parser.hpp>
 #include <boost/program_options.hpp>
+#include <algorithm>
 #include <optional>
 #include <ostream>
 #include <stdexcept>
@@ -11,45 +11,94 @@
 
 namespace bpo = boost::program_options;
 
-std::ostream DecodeImpl::nullOut{nullptr};
-
 ////////////////////////////////////////////////////////////////////////////////
 auto DecodeImpl::configure(int argc, char* argv[]) -> ConfigureRet {
         bpo::options_description appOptionsDescr("Console options.");
 
-        std::string inFileName;
-        std::string outFileName;
+        BatchImpl::Options batchOptions;
         std::string logStreamParam;
+        Options options;
 
         appOptionsDescr.add_options() (
-            "input-file,i",
-            bpo::value(&inFileName)->required(),
-            "In file name."
-        ) (
-            "out-filename,o",
-            bpo::value(&outFileName)->default_value({}),
-            "Out file name."
-        ) (
             "log-stream,l",
             bpo::value(&logStreamParam)->default_value("stdout"),
             "Log stream."
+        ) (
+            "threads",
+            bpo::value(&options.threadsCount)->default_value(1),
+            "Threads count for independent blocks decoding."
+        ) (
+            "offset",
+            bpo::value(&options.offset)->default_value(0),
+            "Decoded data offset in bytes to start output from."
+        ) (
+            "length",
+            bpo::value(&options.length),
+            "Decoded data length in bytes. Up to the end if not set."
         );
 
+        BatchImpl::addOptions(appOptionsDescr, batchOptions);
+
         bpo::variables_map vm;
-        bpo::store(bpo::parse_command_line(argc, argv, appOptionsDescr), vm);
+        BatchImpl::store(argc, argv, appOptionsDescr, vm);
         bpo::notify(vm);
 
-        outFileName = outFileName.empty()
-            ? inFileName + "-decoded"
-            : outFileName;
-        
         auto& outStrem = LogStreamGet::getLogStream(logStreamParam);
-        auto filesOpener = FileOpener(inFileName, outFileName, outStrem);
-        auto decoded = ael::DataParser(filesOpener.getInData());
 
         return {
             outStrem,
-            std::move(filesOpener),
-            std::move(decoded)
+            BatchImpl::makeJobs(batchOptions, "-decoded"),
+            batchOptions,
+            options
         };
-} 
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto DecodeImpl::openFile(const BatchImpl::Job& job,
+                          std::ostream& logStream,
+                          Stats& stats) -> File {
+    auto filesOpener = FileOpener(job.inFileName, job.outFileName, logStream,
+                                  stats);
+    auto decoded = ael::DataParser(filesOpener.getInData());
+    return {
+        logStream,
+        std::move(filesOpener),
+        std::move(decoded)
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto DecodeImpl::_getPieces(const FramesLayout& layout,
+                            std::uint16_t symBitLen) -> _Pieces {
+    auto ret = _Pieces();
+    ret.bounds.push_back(0);
+    ret.dataOffsets.push_back(0);
+    std::uint64_t wordsCount = 0;
+    for (std::size_t i = 1; i < layout.frames.size(); ++i) {
+        // Not last frames hold a whole number of bytes, as checked by
+        // FramesLayout::takeFrom().
+        wordsCount += layout.frames[i - 1].wordsCount;
+        ret.bounds.push_back(wordsCount * symBitLen / 8);
+        ret.dataOffsets.push_back(
+            ret.dataOffsets.back() + layout.frames[i - 1].bytesCount);
+    }
+    ret.bounds.push_back(
+        (layout.wordsCount * symBitLen + layout.tailSize) / 8);
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DecodeImpl::_putPiece(std::vector<std::byte>&& pieceData,
+                           std::uint64_t outOffset,
+                           std::optional<OutStreamSink>& sink,
+                           std::span<std::byte> outData) {
+    if (pieceData.empty()) {
+        return;
+    }
+    if (sink) {
+        sink->put(std::move(pieceData));
+    } else {
+        std::copy(pieceData.begin(), pieceData.end(),
+                  outData.begin() + outOffset);
+    }
+}
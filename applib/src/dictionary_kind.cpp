@@ -0,0 +1,45 @@
+#include <applib/dictionary_kind.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr const char* dictionaryKindNames[] = {"segment-tree", "fenwick"};
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+DictionaryKind takeDictionaryKind(std::uint8_t value, std::uint16_t numBits) {
+    if (value >= std::size(dictionaryKindNames)) {
+        throw std::runtime_error("Unknown dictionary kind.");
+    }
+    const auto ret = static_cast<DictionaryKind>(value);
+    if (ret == DictionaryKind::Fenwick && numBits > fenwickMaxWordBits) {
+        throw std::runtime_error("Fenwick dictionary takes words up to 16 "
+                                 "bits.");
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::istream& operator>>(std::istream& in, DictionaryKind& kind) {
+    auto name = std::string();
+    in >> name;
+    const auto found = std::find(std::begin(dictionaryKindNames),
+                                 std::end(dictionaryKindNames), name);
+    if (found == std::end(dictionaryKindNames)) {
+        in.setstate(std::ios::failbit);
+    } else {
+        kind = static_cast<DictionaryKind>(
+            found - std::begin(dictionaryKindNames));
+    }
+    return in;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::ostream& operator<<(std::ostream& out, DictionaryKind kind) {
+    return out << dictionaryKindNames[static_cast<std::size_t>(kind)];
+}
@@ -0,0 +1,79 @@
+#include <applib/encode_impl.hpp>
+
+#include <numeric>
+#include <stdexcept>
+#include <variant>
+
+#include <boost/program_options.hpp>
+
+namespace bpo = boost::program_options;
+
+////////////////////////////////////////////////////////////////////////////////
+void EncodeImpl::addOptions(bpo::options_description& descr,
+                            Options& options) {
+    addFramesOptions(descr, options);
+    descr.add_options() (
+        "coder",
+        bpo::value(&options.coder)->default_value(
+            FramesLayout::Coder::Arithmetic)->notifier(
+                [](FramesLayout::Coder coder) {
+                    // Semi-static coders have their own archievers.
+                    if (coder != FramesLayout::Coder::Arithmetic
+                            && coder != FramesLayout::Coder::Range) {
+                        throw std::runtime_error("Coder must be "
+                                                 "\"arithmetic\" or "
+                                                 "\"range\".");
+                    }
+                }),
+        "Entropy coder: \"arithmetic\" (bit-wise) or \"range\" (byte-wise, "
+        "faster)."
+    ) (
+        "coder-states",
+        bpo::value(&options.statesCount)->default_value(1),
+        "Interleaved range coder states count: 1, 2, 4 or 8."
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void EncodeImpl::addFramesOptions(bpo::options_description& descr,
+                                  Options& options) {
+    descr.add_options() (
+        "chunk-size",
+        bpo::value(&options.chunkSize)->default_value(defaultChunkSize),
+        "Input chunk size in bytes."
+    ) (
+        "block-size",
+        bpo::value(&options.blockSize)->default_value(0),
+        "Independent block size in bytes. Zero for one model for the whole "
+        "file."
+    ) (
+        "threads",
+        bpo::value(&options.threadsCount)->default_value(1),
+        "Threads count for blocks encoding."
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void EncodeImpl::_putChunk(_EncodedChunk&& encodedChunk,
+                           FramesLayout& layout,
+                           OutStreamSink& sink,
+                           Stats& stats) {
+    if (encodedChunk.frame.wordsCount != 0) {
+        layout.frames.push_back(encodedChunk.frame);
+        layout.wordsCount += encodedChunk.frame.wordsCount;
+        auto timer = stats.time(Stats::Phase::Write);
+        std::visit([&](auto& data) { sink.put(std::move(data)); },
+                   encodedChunk.data);
+    }
+    layout.tailSize = encodedChunk.tail.size();
+    layout.tail = std::accumulate(
+        encodedChunk.tail.begin(), encodedChunk.tail.end(), std::uint32_t{0},
+        [](std::uint32_t curr, bool bit) { return (curr << 1) | bit; });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t EncodeImpl::_alignChunkSize(std::size_t chunkSize,
+                                        std::uint16_t numBits) {
+    // Chunk holds a whole number of words, so only the last one has a tail.
+    return std::max<std::size_t>(chunkSize / numBits, 1) * numBits;
+}
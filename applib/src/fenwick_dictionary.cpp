@@ -0,0 +1,24 @@
+#include <applib/fenwick_dictionary.hpp>
+
+#include <algorithm>
+#include <bit>
+
+////////////////////////////////////////////////////////////////////////////////
+FenwickTree::FenwickTree(std::size_t size, std::uint64_t initialCount)
+    : _size(std::bit_ceil(std::max<std::size_t>(size, 1))),
+      _nodes(static_cast<std::uint64_t*>(::operator new[](
+          (_size + 1) * sizeof(std::uint64_t),
+          std::align_val_t{_cacheLineSize}))) {
+    // Node i sums counts (i - lowest bit of i, i], padding counts are zeros.
+    _nodes[0] = 0;
+    for (std::size_t i = 1; i <= _size; ++i) {
+        const auto first = i & (i - 1);
+        _nodes[i] = (std::min(i, size) - std::min(first, size)) * initialCount;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FenwickDictionary::FenwickDictionary(std::uint64_t wordsCount,
+                                     std::uint64_t ratio)
+    : _tree(wordsCount, 1), _counts(wordsCount, 1), _total(wordsCount),
+      _ratio(ratio) {}
@@ -1,49 +1,255 @@
 #include <applib/file_opener.hpp>
 
+#include <algorithm>
+#include <filesystem>
 #include <fmt/format.h>
+#include <iostream>
+#include <limits>
 #include <ostream>
+#include <stdexcept>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define APPLIB_HAS_MMAP
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+std::span<const std::byte> FileOpener::getInData() {
+    if (!_inLoaded) {
+        auto timer = _stats->time(Stats::Phase::Read);
+        if (_inFileName == stdStreamName) {
+            _readStream(std::cin, _finData,
+                        std::numeric_limits<std::size_t>::max());
+            _inData = _finData;
+        } else if ((_finMapped = _mapInFile(_inFileName))) {
+            _inData = { _finMapped.get(), _finMapped.get_deleter().size };
+        } else {
+            _finData = _openInFile(_inFileName);
+            _inData = _finData;
+        }
+        _stats->addBytesIn(_inData.size());
+        _inLoaded = true;
+    }
+    return _inData;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto FileOpener::readInChunk(std::size_t maxSize) -> InChunk {
+    auto ret = InChunk();
+    if (_inLoaded) {
+        ret.data = _inData.subspan(
+            _inChunkOffset, std::min(maxSize, _inData.size() - _inChunkOffset));
+        _inChunkOffset += ret.data.size();
+        return ret;
+    }
+    if (!_reader) {
+        _reader = std::make_unique<AsyncReader>(_inFileName, maxSize);
+    }
+    auto timer = _stats->time(Stats::Phase::Read);
+    ret.owned = _reader->next();
+    ret.data = ret.owned.getData();
+    _stats->addBytesIn(ret.data.size());
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::optional<std::uint64_t> FileOpener::getInSize() const {
+    return _inSize;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
-std::span<const std::byte> FileOpener::getInData() const {
-       return std::span<const std::byte>(_finData.cbegin(), _finData.cend());
+bool FileOpener::isInDataMapped() const {
+    return static_cast<bool>(_finMapped);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-std::ofstream& FileOpener::getOutFileStream() {
+void FileOpener::releaseInData(std::size_t offset) {
+#ifdef APPLIB_HAS_MMAP
+    if (!_finMapped) {
+        return;
+    }
+    static const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const auto releasedSize =
+        std::min(offset, _inData.size()) / pageSize * pageSize;
+    if (releasedSize != 0) {
+        ::madvise(const_cast<std::byte*>(_finMapped.get()),
+                  releasedSize, MADV_DONTNEED);
+    }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::ostream& FileOpener::getOutFileStream() {
+    if (_outStreamed) {
+        return std::cout;
+    }
     return _fout;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::span<std::byte> FileOpener::mapOutData(std::uint64_t size) {
+    if (_outStreamed || size == 0) {
+        return {};
+    }
+    auto timer = _stats->time(Stats::Phase::Write);
+    _foutMapped = _mapOutFile(_outFileName, size);
+    if (!_foutMapped) {
+        return {};
+    }
+    return { _foutMapped.get(), _foutMapped.get_deleter().size };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOpener::releaseOutData(std::size_t offset) {
+#ifdef APPLIB_HAS_MMAP
+    if (!_foutMapped) {
+        return;
+    }
+    static const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const auto size = _foutMapped.get_deleter().size;
+    const auto releasedSize = std::min(offset, size) / pageSize * pageSize;
+    if (releasedSize != 0) {
+        // Dirty pages of a shared mapping stay in the page cache and are
+        // written back by the kernel, they are only unmapped.
+        ::madvise(_foutMapped.get(), releasedSize, MADV_DONTNEED);
+    }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOpener::_Unmapper::operator()(const std::byte* ptr) const {
+#ifdef APPLIB_HAS_MMAP
+    ::munmap(const_cast<std::byte*>(ptr), size);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto FileOpener::_mapInFile(const std::string& fileInName) -> _MappedData {
+#ifdef APPLIB_HAS_MMAP
+    const int fd = ::open(fileInName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat finStat;
+    // Pipes, character devices and empty files can not be mapped.
+    if (::fstat(fd, &finStat) != 0
+            || !S_ISREG(finStat.st_mode)
+            || finStat.st_size == 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    const auto size = static_cast<std::size_t>(finStat.st_size);
+    void* ptr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // Mapping keeps its own reference to the file.
+    if (ptr == MAP_FAILED) {
+        return nullptr;
+    }
+    // Words are taken from the beginning to the end exactly once.
+    ::madvise(ptr, size, MADV_SEQUENTIAL);
+    ::madvise(ptr, size, MADV_WILLNEED);
+    return _MappedData(static_cast<const std::byte*>(ptr), _Unmapper{size});
+#else
+    return nullptr;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto FileOpener::_mapOutFile(const std::string& fileOutName,
+                             std::uint64_t size) -> _MappedOutData {
+#ifdef APPLIB_HAS_MMAP
+    const int fd = ::open(fileOutName.c_str(), O_RDWR);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat foutStat;
+    if (::fstat(fd, &foutStat) != 0 || !S_ISREG(foutStat.st_mode)) {
+        ::close(fd);
+        return nullptr;
+    }
+    // Space is reserved beforehand: a write to a mapped page which does not
+    // fit on disk would kill the process instead of failing.
+    void* ptr = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(size)) == 0
+            && ::posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0) {
+        ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (ptr == MAP_FAILED) {
+        // Output goes to the stream then, it starts from an empty file.
+        [[maybe_unused]] const auto ret = ::ftruncate(fd, 0);
+        ::close(fd);
+        return nullptr;
+    }
+    ::close(fd);  // Mapping keeps its own reference to the file.
+    return _MappedOutData(static_cast<std::byte*>(ptr),
+                          _Unmapper{static_cast<std::size_t>(size)});
+#else
+    return nullptr;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<std::byte>
-FileOpener::_openInFile(const std::string& fileInName,
-                        std::ostream& optOs) {
-    std::ifstream fin{fileInName, std::ifstream::ate | std::ifstream::binary};
+FileOpener::_openInFile(const std::string& fileInName) {
+    std::ifstream fin{fileInName, std::ifstream::binary};
     if (!fin.is_open()) {
         throw std::runtime_error(
             fmt::format("Could not open file: \"{}\"", fileInName));
     }
 
-    fin.unsetf(std::ios::skipws);  // Not to eat newlines.
-    std::streampos finSize;
-    fin.seekg(0, std::ios::end);
-    finSize = fin.tellg();
-    optOs << fmt::format("File size: {}.", finSize) << std::endl;
-    fin.seekg(0, std::ios::beg);
-
-    auto ret = std::vector<std::byte>(finSize);
-    fin.read(reinterpret_cast<char*>(ret.data()), finSize);
+    auto ret = std::vector<std::byte>();
+    _readStream(fin, ret, std::numeric_limits<std::size_t>::max());
     return ret;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::size_t FileOpener::_readStream(std::istream& in,
+                                    std::vector<std::byte>& out,
+                                    std::size_t maxSize) {
+    // Size can not be known beforehand for pipes, so read by blocks.
+    constexpr std::size_t readBlockSize = 1 << 16;
+    const auto startSize = out.size();
+    while (in && out.size() - startSize < maxSize) {
+        const auto oldSize = out.size();
+        const auto blockSize =
+            std::min(readBlockSize, maxSize - (oldSize - startSize));
+        out.resize(oldSize + blockSize);
+        in.read(reinterpret_cast<char*>(out.data() + oldSize),
+                static_cast<std::streamsize>(blockSize));
+        out.resize(oldSize + in.gcount());
+    }
+    return out.size() - startSize;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 FileOpener::FileOpener(const std::string& inFileName,
                        const std::string& outFileName,
-                       std::ostream& optOs)
-        : _finData(_openInFile(inFileName, optOs)),
-          _fout(outFileName, std::ios::binary) {
-    if (!_fout.is_open()) {
-        throw std::runtime_error(
-            fmt::format("Could not open file: \"{}\"", outFileName));
+                       std::ostream& optOs,
+                       Stats& stats)
+        : _inFileName(inFileName),
+          _outFileName(outFileName),
+          _outStreamed(outFileName == stdStreamName),
+          _stats(&stats) {
+    if (inFileName != stdStreamName) {
+        auto error = std::error_code();
+        const auto status = std::filesystem::status(inFileName, error);
+        if (error || !std::filesystem::exists(status)) {
+            throw std::runtime_error(
+                fmt::format("Could not open file: \"{}\"", inFileName));
+        }
+        if (std::filesystem::is_regular_file(status)) {
+            _inSize = std::filesystem::file_size(inFileName);
+            optOs << fmt::format("File size: {}.", *_inSize) << std::endl;
+        }
     }
-}
\ No newline at end of file
+
+    if (!_outStreamed) {
+        _fout.open(outFileName, std::ios::binary);
+        if (!_fout.is_open()) {
+            throw std::runtime_error(
+                fmt::format("Could not open file: \"{}\"", outFileName));
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#include <applib/frames_layout.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include <ael/data_parser.hpp>
+
+#include <applib/range_coder.hpp>
+
+namespace {
+
+constexpr std::size_t frameRecordSize =
+    3 * sizeof(std::uint64_t);
+
+constexpr std::size_t trailerSize =
+    3 * sizeof(std::uint64_t) + sizeof(std::uint16_t) + sizeof(std::uint32_t)
+    + 2 * sizeof(std::uint8_t);
+
+constexpr std::uint16_t maxTailSize = 32;
+
+constexpr const char* coderNames[] = {"arithmetic", "range", "rans",
+                                      "huffman"};
+
+//----------------------------------------------------------------------------//
+std::uint64_t addChecked(std::uint64_t lhs, std::uint64_t rhs) {
+    if (rhs > std::numeric_limits<std::uint64_t>::max() - lhs) {
+        throw std::runtime_error("Wrong frames table of encoded data.");
+    }
+    return lhs + rhs;
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+void FramesLayout::putTo(ael::ByteDataConstructor& dataConstructor) const {
+    for (const auto& frame: frames) {
+        dataConstructor.putT<std::uint64_t>(frame.wordsCount);
+        dataConstructor.putT<std::uint64_t>(frame.bitsCount);
+        dataConstructor.putT<std::uint64_t>(frame.bytesCount);
+    }
+    dataConstructor.putT<std::uint64_t>(wordsCount);
+    dataConstructor.putT<std::uint64_t>(frames.size());
+    dataConstructor.putT<std::uint64_t>(blockSize);
+    dataConstructor.putT<std::uint16_t>(tailSize);
+    dataConstructor.putT<std::uint32_t>(tail);
+    dataConstructor.putT<std::uint8_t>(static_cast<std::uint8_t>(coder));
+    dataConstructor.putT<std::uint8_t>(statesCount);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FramesLayout FramesLayout::takeFrom(std::span<const std::byte> data,
+                                    std::uint16_t symBitLen) {
+    if (data.size() < trailerSize) {
+        throw std::runtime_error("Encoded data is too short.");
+    }
+    auto ret = FramesLayout();
+    auto trailer = ael::DataParser(data.last(trailerSize));
+    ret.wordsCount = trailer.takeT<std::uint64_t>();
+    const auto framesCount = trailer.takeT<std::uint64_t>();
+    ret.blockSize = trailer.takeT<std::uint64_t>();
+    ret.tailSize = trailer.takeT<std::uint16_t>();
+    ret.tail = trailer.takeT<std::uint32_t>();
+    if (ret.tailSize > maxTailSize || ret.tailSize >= symBitLen) {
+        throw std::runtime_error("Wrong tail size of encoded data.");
+    }
+    const auto coder = trailer.takeT<std::uint8_t>();
+    if (coder >= std::size(coderNames)) {
+        throw std::runtime_error("Unknown coder of encoded data.");
+    }
+    ret.coder = static_cast<Coder>(coder);
+    ret.statesCount = trailer.takeT<std::uint8_t>();
+    if (!RangeCoder::isStatesCount(ret.statesCount)
+            || (ret.statesCount != 1 && ret.coder != Coder::Range)) {
+        throw std::runtime_error("Wrong coder states count.");
+    }
+
+    if ((data.size() - trailerSize) / frameRecordSize < framesCount) {
+        throw std::runtime_error("Encoded data is too short for frames table.");
+    }
+    auto table = ael::DataParser(
+        data.last(trailerSize + framesCount * frameRecordSize));
+    ret.frames.resize(framesCount);
+    // Counts come from the input, so sums are checked before any use.
+    std::uint64_t wordsCount = 0;
+    std::uint64_t bytesCount = 0;
+    for (std::size_t i = 0; i < ret.frames.size(); ++i) {
+        auto& frame = ret.frames[i];
+        frame.wordsCount = table.takeT<std::uint64_t>();
+        frame.bitsCount = table.takeT<std::uint64_t>();
+        frame.bytesCount = table.takeT<std::uint64_t>();
+        // Not last frames decode to a whole number of bytes, remainders
+        // modulo 8 do not depend on overflow.
+        const bool isAligned = frame.wordsCount * symBitLen % 8 == 0;
+        if (frame.bitsCount / 8 + (frame.bitsCount % 8 != 0)
+                    > frame.bytesCount
+                || (i + 1 != ret.frames.size() && !isAligned)) {
+            throw std::runtime_error("Wrong frames table of encoded data.");
+        }
+        wordsCount = addChecked(wordsCount, frame.wordsCount);
+        bytesCount = addChecked(bytesCount, frame.bytesCount);
+    }
+    if (wordsCount != ret.wordsCount
+            || wordsCount > (std::numeric_limits<std::uint64_t>::max()
+                             - ret.tailSize) / symBitLen) {
+        throw std::runtime_error("Wrong frames table of encoded data.");
+    }
+    if (data.size() - ret.getTableBytesCount() < bytesCount) {
+        throw std::runtime_error("Encoded data is too short for frames.");
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FramesLayout::hasIndependentFrames() const {
+    return blockSize != 0 || coder == Coder::Rans
+        || coder == Coder::Huffman;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::span<const std::byte>
+FramesLayout::getFramesData(std::span<const std::byte> data) const {
+    const auto framesEnd = data.size() - getTableBytesCount();
+    return data.subspan(framesEnd - getFramesBytesCount(),
+                        getFramesBytesCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t FramesLayout::getFramesBytesCount() const {
+    return std::accumulate(frames.begin(), frames.end(), std::size_t{0},
+                           [](std::size_t curr, const Frame& frame) {
+                               return curr + frame.bytesCount;
+                           });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t FramesLayout::getTableBytesCount() const {
+    return frames.size() * frameRecordSize + trailerSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::istream& operator>>(std::istream& in, FramesLayout::Coder& coder) {
+    auto name = std::string();
+    in >> name;
+    const auto found = std::find(std::begin(coderNames), std::end(coderNames),
+                                 name);
+    if (found == std::end(coderNames)) {
+        in.setstate(std::ios::failbit);
+    } else {
+        coder = static_cast<FramesLayout::Coder>(
+            found - std::begin(coderNames));
+    }
+    return in;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::ostream& operator<<(std::ostream& out, FramesLayout::Coder coder) {
+    return out << coderNames[static_cast<std::size_t>(coder)];
+}
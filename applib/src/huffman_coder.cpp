@@ -0,0 +1,231 @@
+#include <applib/huffman_coder.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+constexpr std::size_t maxTreeDepth = 64;
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+auto HuffmanCoder::_makeTable(std::span<const std::uint32_t> counts)
+    -> _Table {
+    auto ret = _Table();
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        if (counts[i] != 0) {
+            ret.symbols.push_back(static_cast<std::uint16_t>(i));
+        }
+    }
+    const auto leavesCount = ret.symbols.size();
+    if (leavesCount <= 1) {
+        ret.lengths.assign(leavesCount, 1);
+        return ret;
+    }
+
+    // Huffman tree: leaves first, then internal nodes in creation order, so
+    // a parent has a greater index than its children.
+    using Node = std::pair<std::uint64_t, std::size_t>;
+    auto queue =
+        std::priority_queue<Node, std::vector<Node>, std::greater<Node>>();
+    for (std::size_t i = 0; i < leavesCount; ++i) {
+        queue.emplace(counts[ret.symbols[i]], i);
+    }
+    auto parents = std::vector<std::size_t>(2 * leavesCount - 1);
+    for (auto node = leavesCount; queue.size() > 1; ++node) {
+        const auto [lhsCount, lhs] = queue.top();
+        queue.pop();
+        const auto [rhsCount, rhs] = queue.top();
+        queue.pop();
+        parents[lhs] = node;
+        parents[rhs] = node;
+        queue.emplace(lhsCount + rhsCount, node);
+    }
+    auto depths = std::vector<std::size_t>(parents.size());
+    for (auto node = parents.size() - 1; node-- != 0;) {
+        depths[node] = depths[parents[node]] + 1;
+    }
+
+    // Lengths are limited by moving codes from the deepest levels up, then
+    // given back to words from the most frequent one.
+    auto lengthsCounts = std::array<std::uint32_t, maxTreeDepth>();
+    for (std::size_t i = 0; i < leavesCount; ++i) {
+        ++lengthsCounts[std::min(depths[i], maxTreeDepth - 1)];
+    }
+    for (auto length = std::size_t{maxCodeBits} + 1; length < maxTreeDepth;
+            ++length) {
+        lengthsCounts[maxCodeBits] += lengthsCounts[length];
+        lengthsCounts[length] = 0;
+    }
+    std::uint64_t kraft = 0;
+    for (std::size_t length = 1; length <= maxCodeBits; ++length) {
+        kraft += std::uint64_t{lengthsCounts[length]} << (maxCodeBits - length);
+    }
+    for (; kraft > (std::uint64_t{1} << maxCodeBits); --kraft) {
+        --lengthsCounts[maxCodeBits];
+        for (auto length = std::size_t{maxCodeBits} - 1; length != 0;
+                --length) {
+            if (lengthsCounts[length] != 0) {
+                --lengthsCounts[length];
+                lengthsCounts[length + 1] += 2;
+                break;
+            }
+        }
+    }
+
+    auto order = std::vector<std::size_t>(leavesCount);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::ranges::stable_sort(order, [&](std::size_t lhs, std::size_t rhs) {
+        return counts[ret.symbols[lhs]] > counts[ret.symbols[rhs]];
+    });
+    ret.lengths.resize(leavesCount);
+    auto next = order.begin();
+    for (std::size_t length = 1; length <= maxCodeBits; ++length) {
+        for (std::uint32_t i = 0; i < lengthsCounts[length]; ++i) {
+            ret.lengths[*next++] = static_cast<std::uint8_t>(length);
+        }
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::uint32_t> HuffmanCoder::_makeCodes(const _Table& table) {
+    auto order = std::vector<std::size_t>(table.symbols.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::ranges::stable_sort(order, [&](std::size_t lhs, std::size_t rhs) {
+        return table.lengths[lhs] < table.lengths[rhs];
+    });
+    auto ret = std::vector<std::uint32_t>(table.symbols.size());
+    std::uint32_t code = 0;
+    std::uint8_t length = 0;
+    for (const auto i: order) {
+        code <<= table.lengths[i] - length;
+        length = table.lengths[i];
+        ret[i] = code++;
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void HuffmanCoder::_putTable(const _Table& table,
+                             std::vector<std::byte>& out) {
+    const auto count = static_cast<std::uint32_t>(table.symbols.size());
+    for (std::size_t i = 0; i < sizeof(count); ++i) {
+        out.push_back(static_cast<std::byte>(count >> (8 * i)));
+    }
+    for (std::size_t i = 0; i < table.symbols.size(); ++i) {
+        out.push_back(static_cast<std::byte>(table.symbols[i]));
+        out.push_back(static_cast<std::byte>(table.symbols[i] >> 8));
+        out.push_back(static_cast<std::byte>(table.lengths[i]));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto HuffmanCoder::_takeTable(std::span<const std::byte> data,
+                              std::size_t& pos) -> _Table {
+    const auto takeByte = [&]() -> std::uint32_t {
+        if (pos == data.size()) {
+            throw std::runtime_error("Huffman frame is too short.");
+        }
+        return std::to_integer<std::uint32_t>(data[pos++]);
+    };
+    std::uint32_t count = 0;
+    for (std::size_t i = 0; i < sizeof(count); ++i) {
+        count |= takeByte() << (8 * i);
+    }
+    if (count > (std::uint32_t{1} << maxWordBits)) {
+        throw std::runtime_error("Wrong huffman code lengths table.");
+    }
+    auto ret = _Table();
+    std::uint64_t kraft = 0;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const auto low = takeByte();
+        const auto symbol = static_cast<std::uint16_t>(low | takeByte() << 8);
+        const auto length = static_cast<std::uint8_t>(takeByte());
+        if ((!ret.symbols.empty() && symbol <= ret.symbols.back())
+                || length == 0 || length > maxCodeBits) {
+            throw std::runtime_error("Wrong huffman code lengths table.");
+        }
+        ret.symbols.push_back(symbol);
+        ret.lengths.push_back(length);
+        kraft += std::uint64_t{1} << (maxCodeBits - length);
+    }
+    if (kraft > (std::uint64_t{1} << maxCodeBits)) {
+        throw std::runtime_error("Wrong huffman code lengths table.");
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto HuffmanCoder::_makeDecoder(const _Table& table) -> _Decoder {
+    auto ret = _Decoder();
+    ret.counts.fill(0);
+    for (const auto length: table.lengths) {
+        ++ret.counts[length];
+    }
+    std::uint32_t code = 0;
+    std::uint32_t index = 0;
+    for (std::size_t length = 0; length <= maxCodeBits; ++length) {
+        ret.firstCodes[length] = code;
+        ret.firstIndices[length] = index;
+        code = (code + ret.counts[length]) << 1;
+        index += ret.counts[length];
+    }
+    ret.sortedSymbols.resize(table.symbols.size());
+    auto nextIndices = ret.firstIndices;
+    for (std::size_t i = 0; i < table.symbols.size(); ++i) {
+        ret.sortedSymbols[nextIndices[table.lengths[i]]++] = table.symbols[i];
+    }
+
+    // Entries of one word.
+    ret.entries.resize(std::size_t{1} << lookupBits);
+    for (std::uint8_t length = 1; length <= lookupBits; ++length) {
+        const auto span = std::size_t{1} << (lookupBits - length);
+        for (std::uint32_t i = 0; i < ret.counts[length]; ++i) {
+            const auto symbol =
+                ret.sortedSymbols[ret.firstIndices[length] + i];
+            const auto first = (ret.firstCodes[length] + i) * span;
+            std::fill_n(ret.entries.begin() + first, span,
+                        _Entry{{symbol, 0}, 1, length, length});
+        }
+    }
+
+    // Second word is added if its code is within the looked up bits too.
+    const auto singles = ret.entries;
+    const auto mask = (std::size_t{1} << lookupBits) - 1;
+    for (std::size_t i = 0; i < singles.size(); ++i) {
+        const auto& first = singles[i];
+        if (first.count == 0 || first.bits == lookupBits) {
+            continue;
+        }
+        const auto& second = singles[(i << first.bits) & mask];
+        if (second.count != 0 && first.bits + second.bits <= lookupBits) {
+            ret.entries[i] = {{first.symbols[0], second.symbols[0]}, 2,
+                              first.bits,
+                              static_cast<std::uint8_t>(first.bits
+                                                        + second.bits)};
+        }
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint16_t HuffmanCoder::_decodeLong(const _Decoder& decoder,
+                                        std::uint64_t window,
+                                        std::uint8_t& bits) {
+    for (std::uint8_t length = lookupBits + 1; length <= maxCodeBits;
+            ++length) {
+        const auto offset = static_cast<std::uint32_t>(window >> (64 - length))
+            - decoder.firstCodes[length];
+        if (offset < decoder.counts[length]) {
+            bits = length;
+            return decoder.sortedSymbols[decoder.firstIndices[length] + offset];
+        }
+    }
+    throw std::runtime_error("Wrong huffman code.");
+}
@@ -0,0 +1,101 @@
+#include <applib/out_stream_sink.hpp>
+
+#include <stdexcept>
+#include <type_traits>
+
+////////////////////////////////////////////////////////////////////////////////
+OutStreamSink::OutStreamSink(std::ostream& out, std::size_t maxPending)
+    : _out(out),
+      _maxPending(std::max<std::size_t>(maxPending, 1)),
+      _writer([this]{ _writeLoop(); }) {}
+
+////////////////////////////////////////////////////////////////////////////////
+OutStreamSink::~OutStreamSink() {
+    _stop();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OutStreamSink::put(ael::ByteDataConstructor&& data) {
+    const auto size = data.size();
+    _put(std::move(data), size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OutStreamSink::put(std::vector<std::byte>&& data) {
+    const auto size = data.size();
+    _put(std::move(data), size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OutStreamSink::_put(_Piece&& piece, std::size_t size) {
+    auto lock = std::unique_lock(_mutex);
+    _pendingChanged.wait(lock, [this]{
+        return _pending.size() < _maxPending || _error;
+    });
+    if (_error) {
+        std::rethrow_exception(_error);
+    }
+    _bytesCount += size;
+    _pending.push_back(std::move(piece));
+    _pendingChanged.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OutStreamSink::finish() {
+    _stop();
+    if (_error) {
+        std::rethrow_exception(_error);
+    }
+    _out.flush();
+    if (!_out) {
+        throw std::runtime_error("Could not write data.");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OutStreamSink::_writeLoop() {
+    auto lock = std::unique_lock(_mutex);
+    while (true) {
+        _pendingChanged.wait(lock, [this]{
+            return !_pending.empty() || _stopped;
+        });
+        if (_pending.empty()) {
+            return;  // Stopped and everything is written.
+        }
+        auto piece = std::move(_pending.front());
+        _pending.pop_front();
+        _pendingChanged.notify_all();
+
+        lock.unlock();
+        std::visit([this](const auto& data) {
+            using DataT = std::decay_t<decltype(data)>;
+            if constexpr (std::is_same_v<DataT, ael::ByteDataConstructor>) {
+                _out.write(data.template data<char>(), data.size());
+            } else {
+                _out.write(reinterpret_cast<const char*>(data.data()),
+                           static_cast<std::streamsize>(data.size()));
+            }
+        }, piece);
+        lock.lock();
+
+        if (!_out) {
+            _error = std::make_exception_ptr(
+                std::runtime_error("Could not write data."));
+            _pending.clear();
+            _pendingChanged.notify_all();
+            return;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OutStreamSink::_stop() {
+    {
+        auto lock = std::lock_guard(_mutex);
+        _stopped = true;
+    }
+    _pendingChanged.notify_all();
+    if (_writer.joinable()) {
+        _writer.join();
+    }
+}
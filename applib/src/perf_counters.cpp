@@ -0,0 +1,120 @@
+#include <applib/perf_counters.hpp>
+
+#if __has_include(<linux/perf_event.h>) && __has_include(<sys/syscall.h>)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define APPLIB_HAS_PERF_EVENT
+#endif
+
+namespace {
+
+constexpr auto countersNames = std::array{
+    "cycles", "instructions", "llc_misses", "branch_misses"
+};
+
+#ifdef APPLIB_HAS_PERF_EVENT
+
+constexpr auto countersConfigs = std::array<std::uint64_t, 4>{
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The ThreadCounters class. File descriptors of counters of one
+/// thread.
+///
+class ThreadCounters {
+public:
+    ThreadCounters() {
+        for (std::size_t i = 0; i < PerfCounters::countersCount; ++i) {
+            auto attr = perf_event_attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = countersConfigs[i];
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+                | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            // Counts the calling thread on any CPU.
+            _fds[i] = static_cast<int>(
+                ::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+    }
+
+    ThreadCounters(const ThreadCounters&) = delete;
+
+    ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+    ~ThreadCounters() {
+        for (const int fd: _fds) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    PerfCounters::Values read() const {
+        auto ret = PerfCounters::Values{};
+        for (std::size_t i = 0; i < PerfCounters::countersCount; ++i) {
+            // Value, time enabled, time running.
+            std::uint64_t data[3];
+            if (_fds[i] < 0
+                    || ::read(_fds[i], data, sizeof(data)) != sizeof(data)
+                    || data[2] == 0) {
+                continue;
+            }
+            ret[i] = data[2] == data[1]
+                ? data[0]
+                : static_cast<std::uint64_t>(
+                    static_cast<double>(data[0]) * data[1] / data[2]);
+        }
+        return ret;
+    }
+
+    PerfCounters::Opened getOpened() const {
+        auto ret = PerfCounters::Opened{};
+        for (std::size_t i = 0; i < PerfCounters::countersCount; ++i) {
+            ret[i] = _fds[i] >= 0;
+        }
+        return ret;
+    }
+
+private:
+    std::array<int, PerfCounters::countersCount> _fds;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+const ThreadCounters& getThreadCounters() {
+    thread_local const auto ret = ThreadCounters();
+    return ret;
+}
+
+#endif  // APPLIB_HAS_PERF_EVENT
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+auto PerfCounters::read() -> Values {
+#ifdef APPLIB_HAS_PERF_EVENT
+    return getThreadCounters().read();
+#else
+    return {};
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto PerfCounters::getOpened() -> Opened {
+#ifdef APPLIB_HAS_PERF_EVENT
+    return getThreadCounters().getOpened();
+#else
+    return {};
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const char* PerfCounters::getName(Counter counter) {
+    return countersNames[static_cast<std::size_t>(counter)];
+}
@@ -0,0 +1,79 @@
+#include <applib/progress_meter.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+
+////////////////////////////////////////////////////////////////////////////////
+ProgressMeter::ProgressMeter(std::ostream& optLogOutStream,
+                             std::string label,
+                             std::uint64_t maxProgress,
+                             double bytesPerTick)
+    : _label(std::move(label)),
+      _maxProgress(maxProgress),
+      _bytesPerTick(bytesPerTick),
+      _quiet(optLogOutStream.rdbuf() == nullptr || maxProgress == 0),
+      _start(_Clock::now()),
+      _lastDraw(_start),
+      _bar(indicators::option::BarWidth{50},
+           indicators::option::MaxProgress{maxProgress},
+           indicators::option::ShowPercentage{true},
+           indicators::option::PostfixText{_label},
+           indicators::option::Stream{optLogOutStream}) {
+    if (!_quiet) {
+        _nextCheck = checkStep;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProgressMeter::set(std::uint64_t progress) {
+    _progress = progress;
+    if (!_quiet) {
+        _check();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProgressMeter::finish() {
+    if (_quiet) {
+        return;
+    }
+    _nextCheck = std::numeric_limits<std::uint64_t>::max();
+    _draw();
+    if (!_bar.is_completed()) {
+        _bar.mark_as_completed();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProgressMeter::_check() {
+    _nextCheck = _progress + checkStep;
+    if (_Clock::now() - _lastDraw >= drawInterval) {
+        _draw();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProgressMeter::_draw() {
+    // Bar prints its last line once, when it gets completed.
+    if (_bar.is_completed()) {
+        return;
+    }
+    _lastDraw = _Clock::now();
+    const auto seconds =
+        std::chrono::duration<double>(_lastDraw - _start).count();
+    auto postfix = _label;
+    if (_bytesPerTick != 0 && seconds > 0) {
+        postfix += fmt::format(" {:.1f} MB/s",
+                               _progress * _bytesPerTick / seconds / 1e6);
+    }
+    if (_progress < _maxProgress && _progress != 0) {
+        const auto eta = seconds * (_maxProgress - _progress) / _progress;
+        postfix += fmt::format(" ETA {:.0f}s", eta);
+    } else {
+        postfix += fmt::format(" {:.1f}s", seconds);
+    }
+    _bar.set_option(indicators::option::PostfixText{postfix});
+    _bar.set_progress(std::min(_progress, _maxProgress));
+}
@@ -0,0 +1,148 @@
+#include <applib/rans_coder.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::uint8_t minScaleBits = 12;
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void putLittleEndian(T value, std::vector<std::byte>& out) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<std::byte>(value >> (8 * i)));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+T takeLittleEndian(std::span<const std::byte> data, std::size_t& pos) {
+    if (data.size() - pos < sizeof(T)) {
+        throw std::runtime_error("Rans frame is too short.");
+    }
+    T ret = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        ret |= static_cast<T>(std::to_integer<T>(data[pos++]) << (8 * i));
+    }
+    return ret;
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+auto RansCoder::_makeTable(std::span<const std::uint32_t> counts) -> _Table {
+    auto ret = _Table();
+    const auto total =
+        std::accumulate(counts.begin(), counts.end(), std::uint64_t{0});
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        if (counts[i] != 0) {
+            ret.symbols.push_back(static_cast<std::uint16_t>(i));
+        }
+    }
+    // Quarter of the scale at least for the distinct words to keep rare
+    // words frequencies close to their counts.
+    const auto distinct = ret.symbols.size();
+    ret.scaleBits = static_cast<std::uint8_t>(std::clamp<std::size_t>(
+        std::bit_width(std::max<std::size_t>(distinct, 1) - 1) + 2,
+        minScaleBits, maxWordBits));
+    if (distinct == 0) {
+        return ret;
+    }
+
+    const auto scale = std::uint64_t{1} << ret.scaleBits;
+    std::uint64_t sum = 0;
+    for (const auto symbol: ret.symbols) {
+        const auto freq = std::max<std::uint64_t>(
+            counts[symbol] * scale / total, 1);
+        ret.freqs.push_back(static_cast<std::uint32_t>(freq));
+        sum += freq;
+    }
+
+    // Rounding is fixed on the most frequent words, where it costs least.
+    auto order = std::vector<std::size_t>(distinct);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::ranges::sort(order, [&](std::size_t lhs, std::size_t rhs) {
+        return ret.freqs[lhs] > ret.freqs[rhs];
+    });
+    if (sum < scale) {
+        ret.freqs[order.front()] += static_cast<std::uint32_t>(scale - sum);
+    }
+    while (sum > scale) {
+        for (const auto i: order) {
+            if (sum == scale) {
+                break;
+            }
+            if (ret.freqs[i] > 1) {
+                --ret.freqs[i];
+                --sum;
+            }
+        }
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RansCoder::_putTable(const _Table& table, std::vector<std::byte>& out) {
+    putLittleEndian<std::uint8_t>(table.scaleBits, out);
+    putLittleEndian<std::uint32_t>(
+        static_cast<std::uint32_t>(table.symbols.size()), out);
+    for (std::size_t i = 0; i < table.symbols.size(); ++i) {
+        putLittleEndian<std::uint16_t>(table.symbols[i], out);
+        putLittleEndian<std::uint16_t>(
+            static_cast<std::uint16_t>(table.freqs[i] - 1), out);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto RansCoder::_takeTable(std::span<const std::byte> data,
+                           std::size_t& pos) -> _Table {
+    auto ret = _Table();
+    ret.scaleBits = takeLittleEndian<std::uint8_t>(data, pos);
+    const auto count = takeLittleEndian<std::uint32_t>(data, pos);
+    if (ret.scaleBits < minScaleBits || ret.scaleBits > maxWordBits
+            || count > (std::uint32_t{1} << maxWordBits)) {
+        throw std::runtime_error("Wrong rans frequencies table.");
+    }
+    std::uint64_t sum = 0;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const auto symbol = takeLittleEndian<std::uint16_t>(data, pos);
+        if (!ret.symbols.empty() && symbol <= ret.symbols.back()) {
+            throw std::runtime_error("Wrong rans frequencies table.");
+        }
+        ret.symbols.push_back(symbol);
+        ret.freqs.push_back(
+            std::uint32_t{takeLittleEndian<std::uint16_t>(data, pos)} + 1);
+        sum += ret.freqs.back();
+    }
+    if (count != 0 && sum != (std::uint64_t{1} << ret.scaleBits)) {
+        throw std::runtime_error("Wrong rans frequencies table.");
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto RansCoder::_makeDecodeTable(const _Table& table)
+    -> std::vector<_DecodeEntry> {
+    auto ret = std::vector<_DecodeEntry>(std::size_t{1} << table.scaleBits);
+    auto slot = ret.begin();
+    for (std::size_t i = 0; i < table.symbols.size(); ++i) {
+        for (std::uint32_t j = 0; j < table.freqs[i]; ++j) {
+            *slot++ = {table.freqs[i], table.symbols[i],
+                       static_cast<std::uint16_t>(j)};
+        }
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RansCoder::_putWords(std::span<const std::uint16_t> reversedWords,
+                          std::vector<std::byte>& out) {
+    out.reserve(out.size() + 2 * reversedWords.size());
+    for (auto word = reversedWords.rbegin(); word != reversedWords.rend();
+            ++word) {
+        putLittleEndian<std::uint16_t>(*word, out);
+    }
+}
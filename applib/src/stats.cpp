@@ -0,0 +1,165 @@
+#include <applib/stats.hpp>
+
+#include <ctime>
+
+#include <fmt/format.h>
+
+#if __has_include(<sys/resource.h>)
+#include <sys/resource.h>
+#define APPLIB_HAS_RUSAGE
+#endif
+
+#if __has_include(<malloc.h>) && defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+#include <malloc.h>
+#define APPLIB_HAS_MALLINFO
+#endif
+#endif
+
+namespace {
+
+constexpr auto phasesNames = std::array{
+    "read", "split", "code", "pack", "write"
+};
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+Stats::Timer::Timer(Stats& stats, Phase phase)
+    : _stats(stats),
+      _phase(phase),
+      _wallStart(std::chrono::steady_clock::now()),
+      _cpuStart(_getThreadCpuNs()),
+      _countersStart(stats._perfCounters ? PerfCounters::read()
+                                         : PerfCounters::Values{}) {}
+
+////////////////////////////////////////////////////////////////////////////////
+Stats::Timer::~Timer() {
+    const auto wall = std::chrono::steady_clock::now() - _wallStart;
+    const auto i = static_cast<std::size_t>(_phase);
+    _stats._wallNs[i] += static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(wall).count());
+    _stats._cpuNs[i] += _getThreadCpuNs() - _cpuStart;
+    if (_stats._perfCounters) {
+        const auto counters = PerfCounters::read();
+        for (std::size_t j = 0; j < PerfCounters::countersCount; ++j) {
+            _stats._counters[i][j] += counters[j] - _countersStart[j];
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Stats::Stats(bool enabled, bool perfCounters, bool exclusive)
+    : _enabled(enabled),
+      _perfCounters(perfCounters),
+      _exclusive(exclusive),
+      _countersOpened(perfCounters ? PerfCounters::getOpened()
+                                   : PerfCounters::Opened{}) {}
+
+////////////////////////////////////////////////////////////////////////////////
+void Stats::writeJson(const std::string& inFileName,
+                      const std::string& outFileName,
+                      double wallSeconds,
+                      std::ostream& out) const {
+    auto phases = std::string();
+    std::uint64_t cpuNs = 0;
+    for (std::size_t i = 0; i < _phasesCount; ++i) {
+        phases += fmt::format(
+            "{}\"{}\": {{\"wall_seconds\": {:.6f}, \"cpu_seconds\": {:.6f}",
+            i == 0 ? "" : ", ", phasesNames[i],
+            _wallNs[i].load() / 1e9, _cpuNs[i].load() / 1e9);
+        cpuNs += _cpuNs[i].load();
+        if (_perfCounters) {
+            phases += _countersToJson(i);
+        }
+        phases += "}";
+    }
+    // Control characters are escaped as JSON forbids them in strings, other
+    // bytes are passed as is.
+    const auto quote = [](const std::string& str) {
+        auto ret = std::string("\"");
+        for (const char ch: str) {
+            if (ch == '"' || ch == '\\') {
+                ret += '\\';
+                ret += ch;
+            } else if (static_cast<unsigned char>(ch) < 0x20) {
+                ret += fmt::format("\\u{:04x}",
+                                   static_cast<unsigned char>(ch));
+            } else {
+                ret += ch;
+            }
+        }
+        return ret + '"';
+    };
+    out << fmt::format(
+        "{{\"in_file\": {}, \"out_file\": {}, \"wall_seconds\": {:.6f}, "
+        "\"cpu_seconds\": {:.6f}, \"bytes_in\": {}, \"bytes_out\": {}, "
+        "\"words\": {}, \"bits_per_word\": {}, \"dict_bytes\": {}, "
+        "\"max_rss_kb\": {}, \"phases\": {{{}}}}}",
+        quote(inFileName), quote(outFileName), wallSeconds, cpuNs / 1e9,
+        _bytesIn.load(), _bytesOut.load(), _words.load(), _bitsPerWord,
+        _exclusive ? std::to_string(_dictBytes) : "null",
+        _exclusive ? std::to_string(_getMaxRssKb()) : "null",
+        phases) << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string Stats::_countersToJson(std::size_t phase) const {
+    // Counters which could not be opened are null.
+    auto ret = std::string();
+    for (std::size_t j = 0; j < PerfCounters::countersCount; ++j) {
+        ret += fmt::format(
+            ", \"{}\": {}",
+            PerfCounters::getName(static_cast<PerfCounters::Counter>(j)),
+            _countersOpened[j] ? std::to_string(_counters[phase][j].load())
+                               : "null");
+    }
+    constexpr auto cycles =
+        static_cast<std::size_t>(PerfCounters::Counter::Cycles);
+    constexpr auto instructions =
+        static_cast<std::size_t>(PerfCounters::Counter::Instructions);
+    const auto cyclesCount = _counters[phase][cycles].load();
+    if (_countersOpened[cycles] && _countersOpened[instructions]
+            && cyclesCount != 0) {
+        ret += fmt::format(
+            ", \"ipc\": {:.3f}",
+            static_cast<double>(_counters[phase][instructions].load())
+                / cyclesCount);
+    } else {
+        ret += ", \"ipc\": null";
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint64_t Stats::_getThreadCpuNs() {
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    timespec time;
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0) {
+        return static_cast<std::uint64_t>(time.tv_sec) * 1'000'000'000
+            + static_cast<std::uint64_t>(time.tv_nsec);
+    }
+#endif
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint64_t Stats::_getHeapInUse() {
+#ifdef APPLIB_HAS_MALLINFO
+    const auto info = ::mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint64_t Stats::_getMaxRssKb() {
+#ifdef APPLIB_HAS_RUSAGE
+    rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+        return static_cast<std::uint64_t>(usage.ru_maxrss);
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include <applib/thread_pool.hpp>
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadPool::ThreadPool(std::size_t threadsCount) {
+    threadsCount = std::max<std::size_t>(threadsCount, 1);
+    _workers.reserve(threadsCount);
+    for (std::size_t i = 0; i < threadsCount; ++i) {
+        _workers.emplace_back([this]{ _workLoop(); });
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadPool::~ThreadPool() {
+    {
+        auto lock = std::lock_guard(_mutex);
+        _stopped = true;
+    }
+    _tasksChanged.notify_all();
+    for (auto& worker: _workers) {
+        worker.join();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPool::_workLoop() {
+    while (true) {
+        auto task = std::function<void()>();
+        {
+            auto lock = std::unique_lock(_mutex);
+            _tasksChanged.wait(lock, [this]{
+                return !_tasks.empty() || _stopped;
+            });
+            if (_tasks.empty()) {
+                return;  // Stopped and all tasks are done.
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,47 @@
+#include "alloc_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::uint64_t> allocsCount{0};
+std::atomic<std::uint64_t> allocsBytes{0};
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+void* operator new(std::size_t size) {
+    allocsCount.fetch_add(1, std::memory_order_relaxed);
+    allocsBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AllocCounter::AllocCounter()
+    : _countStart(allocsCount.load()),
+      _bytesStart(allocsBytes.load()) {}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint64_t AllocCounter::getCount() const {
+    return allocsCount.load() - _countStart;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint64_t AllocCounter::getBytes() const {
+    return allocsBytes.load() - _bytesStart;
+}
@@ -0,0 +1,36 @@
+#ifndef APPLIB_TEST_ALLOC_COUNTER_HPP
+#define APPLIB_TEST_ALLOC_COUNTER_HPP
+
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The AllocCounter class. Counts heap allocations of all threads made
+/// since construction. Global operator new of applib_tests is replaced to
+/// count them (see alloc_counter.cpp).
+///
+class AllocCounter {
+public:
+
+    /**
+     * @brief AllocCounter - counter constructor. Starts counting.
+     */
+    AllocCounter();
+
+    /**
+     * @brief getCount - get allocations count.
+     * @return count of operator new calls since construction.
+     */
+    std::uint64_t getCount() const;
+
+    /**
+     * @brief getBytes - get allocated bytes count.
+     * @return bytes asked by operator new calls since construction.
+     */
+    std::uint64_t getBytes() const;
+
+private:
+    const std::uint64_t _countStart;
+    const std::uint64_t _bytesStart;
+};
+
+#endif  // APPLIB_TEST_ALLOC_COUNTER_HPP
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <streambuf>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <applib/bits_writer.hpp>
+#include <applib/decode_impl.hpp>
+#include <applib/ord_and_tail_splitter.hpp>
+#include <applib/out_stream_sink.hpp>
+#include <applib/stats.hpp>
+
+#include "alloc_counter.hpp"
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The NullBuf class. Drops everything written.
+///
+class NullBuf : public std::streambuf {
+protected:
+    int_type overflow(int_type ch) override { return ch; }
+
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        return count;
+    }
+};
+
+constexpr std::size_t dataSize = 1 << 20;
+
+}  // namespace
+
+//----------------------------------------------------------------------------//
+TEST(Allocations, SplitterAllocatesOrdsOnce) {
+    const auto data = std::vector<std::byte>(dataSize + 1);
+    auto counter = AllocCounter();
+    const auto ret = OrdAndTailSplitter::process(data, 16);
+    EXPECT_LE(counter.getCount(), 1);
+    EXPECT_LE(counter.getBytes(), dataSize);
+    EXPECT_EQ(std::get<std::vector<std::uint16_t>>(ret.ords).size(),
+              dataSize / 2);
+    EXPECT_EQ(ret.tail.size(), 8);
+}
+
+//----------------------------------------------------------------------------//
+TEST(Allocations, WriterDoesNotAllocate) {
+    const auto ords = std::vector<std::uint16_t>(dataSize / 2, 0x1234);
+    auto out = std::vector<std::byte>(dataSize);
+    auto counter = AllocCounter();
+    auto writer = BitsWriter(out);
+    writer.putOrds(std::span<const std::uint16_t>(ords), 16);
+    EXPECT_EQ(writer.finish(), dataSize);
+    EXPECT_EQ(counter.getCount(), 0);
+}
+
+//----------------------------------------------------------------------------//
+TEST(Allocations, PackDecodedMemoryDoesNotGrowWithWords) {
+    auto out = std::vector<std::byte>(dataSize);
+    auto stats = Stats();
+    auto counter = AllocCounter();
+    auto writer = BitsWriter(out);
+    auto ords = std::vector<std::uint16_t>();
+    DecodeImpl::packDecoded([](auto ordsOut) {
+        for (std::uint64_t i = 0; i < dataSize / 2; ++i) {
+            *ordsOut++ = i;
+        }
+    }, ords, dataSize / 2, writer, 16, stats);
+    EXPECT_EQ(writer.finish(), dataSize);
+    EXPECT_EQ(counter.getCount(), 1);
+    EXPECT_LE(counter.getBytes(), dataSize / 16);
+    EXPECT_EQ(out[2], std::byte{0});
+    EXPECT_EQ(out[3], std::byte{1});
+}
+
+//----------------------------------------------------------------------------//
+TEST(Allocations, SinkTakesDataWithoutCopy) {
+    auto buf = NullBuf();
+    auto os = std::ostream(&buf);
+    auto data = std::vector<std::byte>(dataSize);
+    auto counter = AllocCounter();
+    {
+        auto sink = OutStreamSink(os);
+        sink.put(std::move(data));
+        sink.finish();
+        EXPECT_EQ(sink.getBytesCount(), dataSize);
+    }
+    EXPECT_LE(counter.getBytes(), dataSize / 16);
+}
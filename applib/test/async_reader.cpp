@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <applib/async_reader.hpp>
+
+namespace {
+
+//----------------------------------------------------------------------------//
+std::vector<std::byte> writeTestFile(const std::string& fileName,
+                                     std::size_t size) {
+    auto data = std::vector<std::byte>(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<std::byte>(i * 7 + i / 251);
+    }
+    auto file = std::ofstream(fileName, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()),
+               static_cast<std::streamsize>(data.size()));
+    return data;
+}
+
+//----------------------------------------------------------------------------//
+std::vector<std::byte> readAll(AsyncReader& reader, std::size_t chunkSize) {
+    auto ret = std::vector<std::byte>();
+    while (true) {
+        const auto owned = reader.next();
+        const auto chunk = owned.getData();
+        EXPECT_LE(chunk.size(), chunkSize);
+        ret.insert(ret.end(), chunk.begin(), chunk.end());
+        if (chunk.size() < chunkSize) {
+            break;
+        }
+    }
+    EXPECT_TRUE(reader.next().getData().empty());
+    return ret;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------//
+TEST(AsyncReader, ReadsByChunks) {
+    const auto fileName = (std::filesystem::temp_directory_path()
+                           / "applib_async_reader_test").string();
+    for (const auto size : {0, 1, 4096, 100000, 3 * 4096}) {
+        const auto data = writeTestFile(fileName, size);
+        auto reader = AsyncReader(fileName, 4096);
+        EXPECT_EQ(readAll(reader, 4096), data);
+    }
+    std::filesystem::remove(fileName);
+}
+
+//----------------------------------------------------------------------------//
+TEST(AsyncReader, DeepReadAhead) {
+    const auto fileName = (std::filesystem::temp_directory_path()
+                           / "applib_async_reader_deep_test").string();
+    const auto data = writeTestFile(fileName, 10 * 1000 + 17);
+    auto reader = AsyncReader(fileName, 1000, 8);
+    EXPECT_EQ(readAll(reader, 1000), data);
+    std::filesystem::remove(fileName);
+}
+
+//----------------------------------------------------------------------------//
+TEST(AsyncReader, StopsBeforeEnd) {
+    const auto fileName = (std::filesystem::temp_directory_path()
+                           / "applib_async_reader_stop_test").string();
+    const auto data = writeTestFile(fileName, 100000);
+    {
+        auto reader = AsyncReader(fileName, 1000);
+        EXPECT_EQ(reader.next().getData().size(), 1000);
+    }
+    std::filesystem::remove(fileName);
+}
+
+//----------------------------------------------------------------------------//
+TEST(AsyncReader, RecyclesAlignedBuffers) {
+    const auto fileName = (std::filesystem::temp_directory_path()
+                           / "applib_async_reader_recycle_test").string();
+    const auto data = writeTestFile(fileName, 50 * 1000);
+    auto reader = AsyncReader(fileName, 1000, 2);
+    auto buffers = std::set<const std::byte*>();
+    auto read = std::vector<std::byte>();
+    for (auto chunk = reader.next(); !chunk.getData().empty();
+            chunk = reader.next()) {
+        const auto chunkData = chunk.getData();
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(chunkData.data())
+                      % AsyncReader::bufferAlignment, 0);
+        buffers.insert(chunkData.data());
+        read.insert(read.end(), chunkData.begin(), chunkData.end());
+    }
+    EXPECT_EQ(read, data);
+    // Reads in flight and the chunk held.
+    EXPECT_LE(buffers.size(), 4);
+    std::filesystem::remove(fileName);
+}
+
+//----------------------------------------------------------------------------//
+TEST(AsyncReader, ThrowsOnMissingFile) {
+    EXPECT_THROW(AsyncReader("/nonexistent/applib_async_reader", 1000),
+                 std::runtime_error);
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <applib/batch_impl.hpp>
+
+namespace {
+
+//----------------------------------------------------------------------------//
+std::string makeFile(const std::filesystem::path& dir,
+                     const std::string& name) {
+    std::filesystem::create_directories(dir);
+    const auto ret = (dir / name).string();
+    std::ofstream(ret) << "in";
+    return ret;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------//
+TEST(BatchImpl, MakeJobsInOutDir) {
+    const auto dir = std::filesystem::temp_directory_path()
+        / "applib_batch_impl";
+    auto options = BatchImpl::Options();
+    options.inFileNames = {makeFile(dir / "a", "x"), makeFile(dir / "a", "y")};
+    options.outDirName = (dir / "out").string();
+    const auto jobs = BatchImpl::makeJobs(options, "-encoded");
+    ASSERT_EQ(jobs.size(), 2);
+    EXPECT_EQ(jobs[0].outFileName, (dir / "out" / "x-encoded").string());
+    EXPECT_EQ(jobs[1].outFileName, (dir / "out" / "y-encoded").string());
+
+    // Same name from another directory.
+    options.inFileNames.push_back(makeFile(dir / "b", "x"));
+    EXPECT_THROW(BatchImpl::makeJobs(options, "-encoded"),
+                 std::runtime_error);
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <applib/batch_inserter.hpp>
+
+//----------------------------------------------------------------------------//
+TEST(BatchInserter, ConsumesFullBatches) {
+    auto batch = std::vector<std::uint16_t>();
+    batch.reserve(4);
+    auto consumed = std::vector<std::uint16_t>();
+    auto batchesCount = 0;
+    const auto consume = [&](std::span<const std::uint16_t> values) {
+        EXPECT_EQ(values.size(), 4);
+        consumed.insert(consumed.end(), values.begin(), values.end());
+        ++batchesCount;
+    };
+    auto values = std::vector<std::uint64_t>(10);
+    std::iota(values.begin(), values.end(), 0);
+    std::copy(values.begin(), values.end(), BatchInserter(batch, consume));
+    EXPECT_EQ(batchesCount, 2);
+    consumed.insert(consumed.end(), batch.begin(), batch.end());
+    EXPECT_TRUE(std::equal(consumed.begin(), consumed.end(),
+                           values.begin(), values.end()));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BatchInserter, IsOutputIterator) {
+    using Consumer = void(*)(std::span<const std::uint8_t>);
+    using Inserter = BatchInserter<std::uint8_t, Consumer>;
+    EXPECT_TRUE((std::output_iterator<Inserter, std::uint64_t>));
+}
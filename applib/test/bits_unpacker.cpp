@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <applib/bits_unpacker.hpp>
+#include <applib/flow/bits_word_flow.hpp>
+
+namespace {
+
+//----------------------------------------------------------------------------//
+std::vector<std::byte> randomBytes(std::size_t size) {
+    auto gen = std::mt19937(size);
+    auto distr = std::uniform_int_distribution<unsigned>(0, 255);
+    auto ret = std::vector<std::byte>(size);
+    for (auto& b: ret) {
+        b = std::byte(distr(gen));
+    }
+    return ret;
+}
+
+//----------------------------------------------------------------------------//
+template <std::uint16_t numBits, class OrdT>
+void checkSameAsFlow(const std::vector<std::byte>& data) {
+    const auto flow = BitsWordFlow<numBits>(data);
+    auto ords = std::vector<OrdT>(flow.size());
+    BitsUnpacker::unpack(data, numBits, std::span(ords));
+    std::size_t i = 0;
+    for (auto word: flow) {
+        ASSERT_EQ(ords[i], BitsWord<numBits>::ord(word)) << i;
+        ++i;
+    }
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------//
+TEST(BitsUnpacker, Empty) {
+    const auto data = std::array<std::byte, 0>{};
+    auto ords = std::vector<std::uint16_t>();
+    BitsUnpacker::unpack(data, 13, std::span(ords));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsUnpacker, ShortData) {
+    const auto data = std::array{ std::byte{0b10110011}, std::byte{0b01110000} };
+    auto ords = std::vector<std::uint16_t>(1);
+    BitsUnpacker::unpack(data, 12, std::span(ords));
+    EXPECT_EQ(ords[0], 0b101100110111);
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsUnpacker, SameAsFlow9) {
+    checkSameAsFlow<9, std::uint16_t>(randomBytes(1000));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsUnpacker, SameAsFlow13) {
+    checkSameAsFlow<13, std::uint16_t>(randomBytes(1001));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsUnpacker, SameAsFlow15Narrow) {
+    checkSameAsFlow<15, std::uint16_t>(randomBytes(37));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsUnpacker, SameAsFlow5) {
+    checkSameAsFlow<5, std::uint8_t>(randomBytes(99));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsUnpacker, SameAsFlow17) {
+    checkSameAsFlow<17, std::uint32_t>(randomBytes(1003));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsUnpacker, SameAsFlow31) {
+    checkSameAsFlow<31, std::uint32_t>(randomBytes(1004));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsUnpacker, SameAsFlowAllWidths) {
+    const auto data = randomBytes(517);
+    checkSameAsFlow<10, std::uint16_t>(data);
+    checkSameAsFlow<11, std::uint16_t>(data);
+    checkSameAsFlow<12, std::uint16_t>(data);
+    checkSameAsFlow<14, std::uint16_t>(data);
+    checkSameAsFlow<18, std::uint32_t>(data);
+    checkSameAsFlow<19, std::uint32_t>(data);
+    checkSameAsFlow<20, std::uint32_t>(data);
+    checkSameAsFlow<21, std::uint32_t>(data);
+    checkSameAsFlow<22, std::uint32_t>(data);
+    checkSameAsFlow<23, std::uint32_t>(data);
+    checkSameAsFlow<25, std::uint32_t>(data);
+    checkSameAsFlow<26, std::uint32_t>(data);
+    checkSameAsFlow<27, std::uint32_t>(data);
+    checkSameAsFlow<28, std::uint32_t>(data);
+    checkSameAsFlow<29, std::uint32_t>(data);
+    checkSameAsFlow<30, std::uint32_t>(data);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <applib/bits_unpacker.hpp>
+#include <applib/bits_writer.hpp>
+#include <applib/bytes_unpacker.hpp>
+
+namespace {
+
+//----------------------------------------------------------------------------//
+template <class OrdT>
+std::vector<OrdT> randomOrds(std::size_t size, std::uint16_t numBits) {
+    auto gen = std::mt19937(size + numBits);
+    auto distr = std::uniform_int_distribution<std::uint64_t>(
+        0, (std::uint64_t{1} << numBits) - 1);
+    auto ret = std::vector<OrdT>(size);
+    for (auto& ord: ret) {
+        ord = static_cast<OrdT>(distr(gen));
+    }
+    return ret;
+}
+
+//----------------------------------------------------------------------------//
+template <class OrdT>
+void checkRoundTrip(std::size_t size, std::uint16_t numBits) {
+    const auto ords = randomOrds<OrdT>(size, numBits);
+    auto data = std::vector<std::byte>((size * numBits + 7) / 8);
+    auto writer = BitsWriter(data);
+    writer.putOrds(std::span<const OrdT>(ords), numBits);
+    ASSERT_EQ(writer.finish(), data.size());
+
+    auto unpacked = std::vector<OrdT>(size);
+    if (numBits % 8 == 0) {
+        BytesUnpacker::unpack(data, numBits / 8, std::span(unpacked));
+    } else {
+        BitsUnpacker::unpack(data, numBits, std::span(unpacked));
+    }
+    EXPECT_EQ(unpacked, ords) << numBits;
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------//
+TEST(BitsWriter, Empty) {
+    auto data = std::array<std::byte, 0>{};
+    auto writer = BitsWriter(data);
+    EXPECT_EQ(writer.finish(), 0);
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsWriter, PutPadsLastByte) {
+    auto data = std::array<std::byte, 2>{};
+    auto writer = BitsWriter(data);
+    writer.put(0b101, 3);
+    writer.put(0b1100110, 7);
+    EXPECT_EQ(writer.finish(), 2);
+    EXPECT_EQ(data[0], std::byte{0b10111001});
+    EXPECT_EQ(data[1], std::byte{0b10000000});
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsWriter, BytesAfterBits) {
+    auto data = std::array<std::byte, 3>{};
+    auto writer = BitsWriter(data);
+    writer.put(0b1111, 4);
+    const auto ords = std::array<std::uint16_t, 1>{ 0x1234 };
+    writer.putOrds(std::span<const std::uint16_t>(ords), 16);
+    EXPECT_EQ(writer.finish(), 3);
+    EXPECT_EQ(data[0], std::byte{0xF1});
+    EXPECT_EQ(data[1], std::byte{0x23});
+    EXPECT_EQ(data[2], std::byte{0x40});
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsWriter, OrdsOutOfBuffer) {
+    auto data = std::array<std::byte, 3>{};
+    const auto ords = std::array<std::uint8_t, 4>{};
+    auto writer = BitsWriter(data);
+    EXPECT_THROW(writer.putOrds(std::span<const std::uint8_t>(ords), 8),
+                 std::runtime_error);
+    // Three words fit on a byte boundary but not after a bit.
+    writer.put(1, 1);
+    EXPECT_THROW(
+        writer.putOrds(std::span<const std::uint8_t>(ords).first(3), 8),
+        std::runtime_error);
+    writer.putOrds(std::span<const std::uint8_t>(ords).first(2), 8);
+    EXPECT_EQ(writer.finish(), 3);
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsWriter, RoundTripBytes) {
+    checkRoundTrip<std::uint8_t>(1000, 8);
+    checkRoundTrip<std::uint16_t>(1001, 16);
+    checkRoundTrip<std::uint32_t>(1002, 24);
+    checkRoundTrip<std::uint32_t>(11, 24);
+    checkRoundTrip<std::uint32_t>(1003, 32);
+}
+
+//----------------------------------------------------------------------------//
+TEST(BitsWriter, RoundTripBits) {
+    for (std::uint16_t numBits = 9; numBits < 16; ++numBits) {
+        checkRoundTrip<std::uint16_t>(997, numBits);
+    }
+    for (std::uint16_t numBits = 17; numBits < 32; ++numBits) {
+        if (numBits != 24) {
+            checkRoundTrip<std::uint32_t>(997, numBits);
+        }
+    }
+}
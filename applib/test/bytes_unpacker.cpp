@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <applib/bytes_unpacker.hpp>
+#include <applib/flow/bytes_word_flow.hpp>
+
+namespace {
+
+//----------------------------------------------------------------------------//
+std::vector<std::byte> randomBytes(std::size_t size) {
+    auto gen = std::mt19937(size);
+    auto distr = std::uniform_int_distribution<unsigned>(0, 255);
+    auto ret = std::vector<std::byte>(size);
+    for (auto& b: ret) {
+        b = std::byte(distr(gen));
+    }
+    return ret;
+}
+
+//----------------------------------------------------------------------------//
+template <std::uint8_t numBytes, class OrdT>
+void checkSameAsFlow(const std::vector<std::byte>& data) {
+    const auto flow = BytesWordFlow<numBytes>(data);
+    auto ords = std::vector<OrdT>(flow.size());
+    BytesUnpacker::unpack(data, numBytes, std::span(ords));
+    std::size_t i = 0;
+    for (auto word: flow) {
+        ASSERT_EQ(ords[i], BytesWord<numBytes>::ord(word)) << i;
+        ++i;
+    }
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------//
+TEST(BytesUnpacker, Empty) {
+    const auto data = std::array<std::byte, 0>{};
+    auto ords = std::vector<std::uint16_t>();
+    BytesUnpacker::unpack(data, 2, std::span(ords));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BytesUnpacker, BigEndian) {
+    const auto data = std::array{ std::byte{0x12}, std::byte{0x34},
+                                  std::byte{0x56} };
+    auto ords = std::vector<std::uint32_t>(1);
+    BytesUnpacker::unpack(data, 3, std::span(ords));
+    EXPECT_EQ(ords[0], 0x123456);
+}
+
+//----------------------------------------------------------------------------//
+TEST(BytesUnpacker, SameAsFlow1) {
+    checkSameAsFlow<1, std::uint8_t>(randomBytes(100));
+    checkSameAsFlow<1, std::uint64_t>(randomBytes(100));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BytesUnpacker, SameAsFlow2) {
+    checkSameAsFlow<2, std::uint16_t>(randomBytes(1001));
+    checkSameAsFlow<2, std::uint32_t>(randomBytes(1001));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BytesUnpacker, SameAsFlow3) {
+    checkSameAsFlow<3, std::uint32_t>(randomBytes(1001));
+    checkSameAsFlow<3, std::uint32_t>(randomBytes(29));
+}
+
+//----------------------------------------------------------------------------//
+TEST(BytesUnpacker, SameAsFlow4) {
+    checkSameAsFlow<4, std::uint32_t>(randomBytes(1003));
+    checkSameAsFlow<4, std::uint64_t>(randomBytes(1003));
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <applib/fenwick_dictionary.hpp>
+#include <applib/range_coder.hpp>
+
+namespace {
+
+//----------------------------------------------------------------------------//
+std::vector<std::uint64_t> makeOrds(std::size_t count,
+                                    std::uint64_t wordsCount) {
+    // Skewed words, a few of them are never seen.
+    auto gen = std::mt19937(11);
+    auto distr = std::geometric_distribution<std::uint64_t>(0.05);
+    auto ret = std::vector<std::uint64_t>(count);
+    for (auto& ord: ret) {
+        ord = distr(gen) % wordsCount;
+    }
+    return ret;
+}
+
+//----------------------------------------------------------------------------//
+template <class DictT>
+void checkIntervals(DictT coderDict, DictT decoderDict,
+                    const std::vector<std::uint64_t>& ords) {
+    for (const auto ord: ords) {
+        const auto total = decoderDict.getTotalWordsCnt();
+        const auto [low, high, coderTotal] =
+            coderDict.getProbabilityStats(ord);
+        ASSERT_EQ(coderTotal, total);
+        ASSERT_LT(low, high);
+        ASSERT_LE(high, total);
+        for (const auto cumulative: {low, low + (high - low) / 2, high - 1}) {
+            ASSERT_EQ(decoderDict.getWordOrd(cumulative), ord);
+        }
+        decoderDict.getProbabilityStats(ord);
+    }
+    EXPECT_EQ(coderDict.getTotalWordsCnt(), decoderDict.getTotalWordsCnt());
+}
+
+//----------------------------------------------------------------------------//
+std::size_t checkRangeCoding(auto makeDict,
+                             const std::vector<std::uint64_t>& ords) {
+    auto data = std::vector<std::byte>();
+    auto coderDict = makeDict();
+    RangeCoder::encode(ords, data, coderDict, []{});
+    auto decoded = std::vector<std::uint64_t>();
+    auto decoderDict = makeDict();
+    RangeCoder::decode(data, decoderDict, std::back_inserter(decoded),
+                       ords.size(), []{});
+    EXPECT_EQ(decoded, ords);
+    return data.size();
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------//
+TEST(FenwickTree, CumulativeAndFind) {
+    constexpr std::size_t size = 37;
+    auto tree = FenwickTree(size, 2);
+    auto counts = std::vector<std::uint64_t>(size, 2);
+    auto gen = std::mt19937(5);
+    auto distr = std::uniform_int_distribution<std::size_t>(0, size - 1);
+    for (std::size_t i = 0; i < 200; ++i) {
+        const auto index = distr(gen);
+        tree.add(index, 3);
+        counts[index] += 3;
+    }
+    // A count is taken back to zero by its negation.
+    tree.add(7, ~counts[7] + 1);
+    counts[7] = 0;
+
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(tree.getLowerCumulative(i), cumulative);
+        for (std::uint64_t j = 0; j < counts[i]; ++j) {
+            EXPECT_EQ(tree.find(cumulative + j), i);
+        }
+        cumulative += counts[i];
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(FenwickDictionary, Intervals) {
+    const auto ords = makeOrds(5000, 256);
+    checkIntervals(FenwickDictionary(256, 3), FenwickDictionary(256, 3),
+                   ords);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FenwickADictionary, Intervals) {
+    const auto ords = makeOrds(5000, 100);
+    checkIntervals(FenwickADictionary(100), FenwickADictionary(100), ords);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FenwickDDictionary, Intervals) {
+    const auto ords = makeOrds(5000, 100);
+    checkIntervals(FenwickDDictionary(100), FenwickDDictionary(100), ords);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FenwickDictionary, AllWordsSeen) {
+    // Escape is gone after the last unseen word.
+    auto ords = std::vector<std::uint64_t>{2, 0, 3, 1, 1, 2, 0, 3, 3};
+    checkIntervals(FenwickADictionary(4), FenwickADictionary(4), ords);
+    checkIntervals(FenwickDDictionary(4), FenwickDDictionary(4), ords);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FenwickDictionary, RangeCoding) {
+    const auto ords = makeOrds(100000, 1 << 16);
+    const auto plainBytes = checkRangeCoding(
+        [] { return FenwickDictionary(1 << 16, 32); }, ords);
+    const auto aBytes = checkRangeCoding(
+        [] { return FenwickADictionary(1 << 16); }, ords);
+    const auto dBytes = checkRangeCoding(
+        [] { return FenwickDDictionary(1 << 16); }, ords);
+
+    // Entropy of geometric(0.05) is about 5.7 bits.
+    for (const auto bytes: {plainBytes, aBytes, dBytes}) {
+        EXPECT_LT(bytes * 8., 6.0 * ords.size());
+    }
+}
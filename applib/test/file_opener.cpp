@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <applib/file_opener.hpp>
+#include <applib/stats.hpp>
+
+//----------------------------------------------------------------------------//
+TEST(FileOpener, MapOutData) {
+    const auto dir = std::filesystem::temp_directory_path();
+    const auto inFileName = (dir / "applib_file_opener_in").string();
+    const auto outFileName = (dir / "applib_file_opener_out").string();
+    std::ofstream(inFileName) << "in";
+    {
+        auto log = std::ostringstream();
+        auto stats = Stats();
+        auto opener = FileOpener(inFileName, outFileName, log, stats);
+        auto outData = opener.mapOutData(1000);
+        ASSERT_EQ(outData.size(), 1000);
+        std::fill(outData.begin(), outData.end(), std::byte{'a'});
+    }
+    auto fin = std::ifstream(outFileName, std::ios::binary);
+    const auto out = std::string(std::istreambuf_iterator<char>(fin), {});
+    EXPECT_EQ(out, std::string(1000, 'a'));
+    std::filesystem::remove(inFileName);
+    std::filesystem::remove(outFileName);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FileOpener, StandardOutputIsNotMapped) {
+    const auto inFileName = (std::filesystem::temp_directory_path()
+                             / "applib_file_opener_std_in").string();
+    std::ofstream(inFileName) << "in";
+    auto log = std::ostringstream();
+    auto stats = Stats();
+    auto opener = FileOpener(inFileName, FileOpener::stdStreamName, log,
+                             stats);
+    EXPECT_TRUE(opener.mapOutData(1000).empty());
+    std::filesystem::remove(inFileName);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <ael/byte_data_constructor.hpp>
+
+#include <applib/frames_layout.hpp>
+
+namespace {
+
+//----------------------------------------------------------------------------//
+std::vector<std::byte> makeData(const FramesLayout& layout,
+                                std::size_t framesBytesCount) {
+    auto table = ael::ByteDataConstructor();
+    layout.putTo(table);
+    auto ret = std::vector<std::byte>(framesBytesCount);
+    ret.insert(ret.end(), table.data<std::byte>(),
+               table.data<std::byte>() + table.size());
+    return ret;
+}
+
+//----------------------------------------------------------------------------//
+FramesLayout makeLayout() {
+    auto ret = FramesLayout();
+    ret.frames = {{10, 75, 10}, {5, 33, 5}};
+    ret.wordsCount = 15;
+    ret.tailSize = 3;
+    ret.tail = 5;
+    return ret;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------//
+TEST(FramesLayout, PutTake) {
+    const auto layout = makeLayout();
+    const auto data = makeData(layout, 15);
+    const auto taken = FramesLayout::takeFrom(data, 8);
+    ASSERT_EQ(taken.frames.size(), 2);
+    EXPECT_EQ(taken.frames[1].wordsCount, 5);
+    EXPECT_EQ(taken.frames[1].bitsCount, 33);
+    EXPECT_EQ(taken.wordsCount, 15);
+    EXPECT_EQ(taken.tailSize, 3);
+    EXPECT_EQ(taken.tail, 5);
+    EXPECT_EQ(taken.getFramesData(data).size(), 15);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FramesLayout, TakeShort) {
+    const auto data = makeData(makeLayout(), 15);
+    EXPECT_THROW(FramesLayout::takeFrom(std::span(data).last(20), 8),
+                 std::runtime_error);
+    // Frames do not fit.
+    EXPECT_THROW(FramesLayout::takeFrom(std::span(data).subspan(1), 8),
+                 std::runtime_error);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FramesLayout, TakeWrongTailSize) {
+    auto layout = makeLayout();
+    layout.tailSize = 33;
+    EXPECT_THROW(FramesLayout::takeFrom(makeData(layout, 15), 8),
+                 std::runtime_error);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FramesLayout, TakeOverflowingBytesCount) {
+    // Sum of bytes counts wraps to the real frames size.
+    auto layout = makeLayout();
+    layout.frames = {{10, 0, std::uint64_t{1} << 63},
+                     {5, 0, (std::uint64_t{1} << 63) + 15}};
+    EXPECT_THROW(FramesLayout::takeFrom(makeData(layout, 15), 8),
+                 std::runtime_error);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FramesLayout, TakeOverflowingWordsCount) {
+    auto layout = makeLayout();
+    layout.frames[0].wordsCount = ~std::uint64_t{0};
+    layout.frames[1].wordsCount = 16;
+    EXPECT_THROW(FramesLayout::takeFrom(makeData(layout, 15), 8),
+                 std::runtime_error);
+
+    // Frames words do not sum up to words count.
+    layout = makeLayout();
+    layout.wordsCount = 16;
+    EXPECT_THROW(FramesLayout::takeFrom(makeData(layout, 15), 8),
+                 std::runtime_error);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FramesLayout, TakeBitsOutOfFrame) {
+    auto layout = makeLayout();
+    layout.frames[1].bitsCount = 41;
+    EXPECT_THROW(FramesLayout::takeFrom(makeData(layout, 15), 8),
+                 std::runtime_error);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FramesLayout, TakeWordSizeMismatch) {
+    // 8 words of 13 bits are 13 bytes.
+    auto layout = makeLayout();
+    layout.frames = {{8, 104, 13}, {7, 91, 12}};
+    const auto data = makeData(layout, 25);
+    EXPECT_NO_THROW(FramesLayout::takeFrom(data, 13));
+    // Tail is not shorter than a word.
+    EXPECT_THROW(FramesLayout::takeFrom(data, 3), std::runtime_error);
+
+    // Not last frame ends inside a byte, so the next one would be decoded
+    // over its last byte.
+    layout.frames = {{7, 91, 12}, {8, 104, 13}};
+    EXPECT_THROW(FramesLayout::takeFrom(makeData(layout, 25), 13),
+                 std::runtime_error);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FramesLayout, IndependentFrames) {
+    auto layout = makeLayout();
+    EXPECT_FALSE(layout.hasIndependentFrames());
+    layout.coder = FramesLayout::Coder::Range;
+    EXPECT_FALSE(layout.hasIndependentFrames());
+    layout.coder = FramesLayout::Coder::Rans;
+    EXPECT_TRUE(layout.hasIndependentFrames());
+    layout.coder = FramesLayout::Coder::Huffman;
+    EXPECT_TRUE(layout.hasIndependentFrames());
+    layout.coder = FramesLayout::Coder::Arithmetic;
+    layout.blockSize = 16;
+    EXPECT_TRUE(layout.hasIndependentFrames());
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <applib/huffman_coder.hpp>
+
+namespace {
+
+//----------------------------------------------------------------------------//
+template <class OrdT>
+std::vector<OrdT> decodeAll(const std::vector<std::byte>& data,
+                            std::size_t wordsCount) {
+    auto ret = std::vector<OrdT>();
+    HuffmanCoder::decode(data, std::back_inserter(ret), wordsCount, []{});
+    return ret;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------//
+TEST(HuffmanCoder, EncodeDecodeSkewed) {
+    auto gen = std::mt19937(42);
+    auto distr = std::geometric_distribution<std::uint16_t>(0.3);
+    auto ords = std::vector<std::uint8_t>(100001);
+    for (auto& ord: ords) {
+        ord = static_cast<std::uint8_t>(
+            std::min<std::uint16_t>(distr(gen), 15));
+    }
+    auto data = std::vector<std::byte>();
+    const auto [wordsCount, bytesCount] =
+        HuffmanCoder::encode(ords, data, []{});
+    EXPECT_EQ(wordsCount, ords.size());
+    EXPECT_EQ(bytesCount, data.size());
+    EXPECT_EQ(decodeAll<std::uint8_t>(data, ords.size()), ords);
+
+    // Entropy of geometric(0.3) is about 2.94 bits.
+    EXPECT_LT(data.size() * 8., 3.1 * ords.size());
+}
+
+//----------------------------------------------------------------------------//
+TEST(HuffmanCoder, EncodeDecodeLongCodes) {
+    // Exponentially falling counts make the tree deeper than code lengths
+    // limit, and codes longer than the lookup bits.
+    auto ords = std::vector<std::uint16_t>();
+    for (std::uint16_t word = 0; word < 30; ++word) {
+        ords.insert(ords.end(), std::size_t{1} << (29 - word) >> 10 | 1,
+                    static_cast<std::uint16_t>(word * 1000));
+    }
+    std::shuffle(ords.begin(), ords.end(), std::mt19937(1));
+    auto data = std::vector<std::byte>();
+    HuffmanCoder::encode(ords, data, []{});
+    EXPECT_EQ(decodeAll<std::uint16_t>(data, ords.size()), ords);
+}
+
+//----------------------------------------------------------------------------//
+TEST(HuffmanCoder, EncodeDecodeWideAlphabet) {
+    auto gen = std::mt19937(7);
+    auto distr = std::uniform_int_distribution<std::uint16_t>(0, 0xFFFF);
+    auto ords = std::vector<std::uint16_t>(200000);
+    for (std::size_t i = 0; i < ords.size(); ++i) {
+        ords[i] = i % 3 == 0 ? distr(gen) : static_cast<std::uint16_t>(i % 5);
+    }
+    auto data = std::vector<std::byte>();
+    HuffmanCoder::encode(ords, data, []{});
+    EXPECT_EQ(decodeAll<std::uint16_t>(data, ords.size()), ords);
+}
+
+//----------------------------------------------------------------------------//
+TEST(HuffmanCoder, EncodeDecodeShort) {
+    for (const auto& ords: {std::vector<std::uint8_t>{7},
+                            std::vector<std::uint8_t>(5, 200),
+                            std::vector<std::uint8_t>{3, 1, 3}}) {
+        auto data = std::vector<std::byte>();
+        HuffmanCoder::encode(ords, data, []{});
+        EXPECT_EQ(decodeAll<std::uint8_t>(data, ords.size()), ords);
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(HuffmanCoder, DecodeWrongTable) {
+    auto data = std::vector<std::byte>();
+    HuffmanCoder::encode(std::vector<std::uint8_t>{1, 2, 2}, data, []{});
+    // Length of the first word, two codes of one bit and one more.
+    data[6] = std::byte{1};
+    data[9] = std::byte{1};
+    data.insert(data.begin() + 10,
+                {std::byte{3}, std::byte{0}, std::byte{1}});
+    data[0] = std::byte{3};
+    EXPECT_THROW(decodeAll<std::uint8_t>(data, 3), std::runtime_error);
+    EXPECT_THROW(decodeAll<std::uint8_t>({std::byte{1}}, 3),
+                 std::runtime_error);
+}
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+
+#include <applib/progress_meter.hpp>
+
+//----------------------------------------------------------------------------//
+TEST(ProgressMeter, TicksDoNotDrawBeforeCheckStep) {
+    auto stream = std::ostringstream();
+    auto progress = ProgressMeter(stream, "Encoding",
+                                  ProgressMeter::checkStep, 1);
+    auto tick = progress.getTick();
+    for (std::uint64_t i = 0; i + 1 < ProgressMeter::checkStep; ++i) {
+        tick();
+    }
+    EXPECT_TRUE(stream.str().empty());
+}
+
+//----------------------------------------------------------------------------//
+TEST(ProgressMeter, FinishDraws) {
+    auto stream = std::ostringstream();
+    auto progress = ProgressMeter(stream, "Encoding", 10, 1);
+    auto tick = progress.getTick();
+    for (int i = 0; i < 10; ++i) {
+        tick();
+    }
+    progress.finish();
+    EXPECT_NE(stream.str().find("Encoding"), std::string::npos);
+}
+
+//----------------------------------------------------------------------------//
+TEST(ProgressMeter, QuietIfNothingToDo) {
+    auto stream = std::ostringstream();
+    auto progress = ProgressMeter(stream, "Encoding", 0, 1);
+    progress.set(0);
+    progress.finish();
+    EXPECT_TRUE(stream.str().empty());
+}
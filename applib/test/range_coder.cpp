@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <applib/range_coder.hpp>
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The TestDictionary class. Adaptive counts of a small alphabet with
+/// the interface of ael dictionaries.
+///
+class TestDictionary {
+public:
+
+    struct ProbabilityStats {
+        std::uint64_t low;
+        std::uint64_t high;
+        std::uint64_t total;
+    };
+
+public:
+
+    TestDictionary(std::size_t wordsCount,
+                   std::uint64_t initialCount,
+                   std::uint64_t step)
+        : _counts(wordsCount, initialCount),
+          _total(wordsCount * initialCount),
+          _step(step) {}
+
+    ProbabilityStats getProbabilityStats(std::uint64_t ord) {
+        std::uint64_t low = 0;
+        for (std::uint64_t i = 0; i < ord; ++i) {
+            low += _counts[i];
+        }
+        const auto ret = ProbabilityStats{low, low + _counts[ord], _total};
+        _counts[ord] += _step;
+        _total += _step;
+        return ret;
+    }
+
+    std::uint64_t getWordOrd(std::uint64_t cumulativeCount) const {
+        std::uint64_t ord = 0;
+        for (; cumulativeCount >= _counts[ord]; ++ord) {
+            cumulativeCount -= _counts[ord];
+        }
+        return ord;
+    }
+
+    std::uint64_t getTotalWordsCnt() const { return _total; }
+
+private:
+    std::vector<std::uint64_t> _counts;
+    std::uint64_t _total;
+    std::uint64_t _step;
+};
+
+//----------------------------------------------------------------------------//
+std::vector<std::uint64_t> decodeAll(const std::vector<std::byte>& data,
+                                     TestDictionary dict,
+                                     std::size_t wordsCount,
+                                     std::size_t statesCount = 1) {
+    auto ret = std::vector<std::uint64_t>();
+    RangeCoder::decode(data, dict, std::back_inserter(ret), wordsCount,
+                       []{}, statesCount);
+    return ret;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------//
+TEST(RangeCoder, EncodeDecodeSkewed) {
+    auto gen = std::mt19937(42);
+    auto distr = std::geometric_distribution<std::uint64_t>(0.3);
+    auto ords = std::vector<std::uint64_t>(100000);
+    for (auto& ord: ords) {
+        ord = std::min<std::uint64_t>(distr(gen), 15);
+    }
+    auto data = std::vector<std::byte>();
+    auto dict = TestDictionary(16, 1, 1);
+    const auto [wordsCount, bytesCount] =
+        RangeCoder::encode(ords, data, dict, []{});
+    EXPECT_EQ(wordsCount, ords.size());
+    EXPECT_EQ(bytesCount, data.size());
+    EXPECT_EQ(decodeAll(data, TestDictionary(16, 1, 1), ords.size()), ords);
+
+    // Entropy of geometric(0.3) is about 2.94 bits.
+    EXPECT_LT(data.size() * 8., 3.0 * ords.size());
+}
+
+//----------------------------------------------------------------------------//
+TEST(RangeCoder, EncodeDecodeLargeTotals) {
+    auto gen = std::mt19937(7);
+    auto distr = std::uniform_int_distribution<std::uint64_t>(0, 3);
+    auto ords = std::vector<std::uint64_t>(10000);
+    for (auto& ord: ords) {
+        ord = distr(gen);
+    }
+    // Totals near 2^50 leave only a few bits of range per count.
+    const auto makeDict = [] {
+        return TestDictionary(4, std::uint64_t{1} << 48,
+                              std::uint64_t{1} << 36);
+    };
+    auto data = std::vector<std::byte>();
+    auto dict = makeDict();
+    RangeCoder::encode(ords, data, dict, []{});
+    EXPECT_EQ(decodeAll(data, makeDict(), ords.size()), ords);
+}
+
+//----------------------------------------------------------------------------//
+TEST(RangeCoder, TotalsOutOfPrecision) {
+    const auto ords = std::vector<std::uint64_t>{0, 1, 1, 0};
+    auto data = std::vector<std::byte>();
+    auto dict = TestDictionary(2, RangeCoder::minRange, 0);
+    EXPECT_THROW(RangeCoder::encode(ords, data, dict, []{}),
+                 std::runtime_error);
+    EXPECT_THROW(decodeAll(std::vector<std::byte>(16),
+                           TestDictionary(2, RangeCoder::minRange, 0), 1),
+                 std::runtime_error);
+
+    // Total grows above 2^56 while coding.
+    data.clear();
+    auto growingDict = TestDictionary(2, std::uint64_t{1} << 54,
+                                      std::uint64_t{1} << 54);
+    EXPECT_THROW(RangeCoder::encode(ords, data, growingDict, []{}, 2),
+                 std::runtime_error);
+}
+
+//----------------------------------------------------------------------------//
+TEST(RangeCoder, EncodeDecodeCarries) {
+    // Uniform words over a total which is not a power of two carry to the
+    // coded bytes thousands of times.
+    auto gen = std::mt19937(1);
+    auto distr = std::uniform_int_distribution<std::uint64_t>(0, 6);
+    auto ords = std::vector<std::uint64_t>(50000);
+    for (auto& ord: ords) {
+        ord = distr(gen);
+    }
+    auto data = std::vector<std::byte>();
+    auto dict = TestDictionary(7, 1, 0);
+    RangeCoder::encode(ords, data, dict, []{});
+    EXPECT_EQ(decodeAll(data, TestDictionary(7, 1, 0), ords.size()), ords);
+}
+
+//----------------------------------------------------------------------------//
+TEST(RangeCoder, EncodeDecodeInterleaved) {
+    auto gen = std::mt19937(3);
+    auto distr = std::uniform_int_distribution<std::uint64_t>(0, 6);
+    auto ords = std::vector<std::uint64_t>(50003);
+    for (auto& ord: ords) {
+        ord = distr(gen);
+    }
+    auto single = std::vector<std::byte>();
+    auto dict = TestDictionary(7, 1, 1);
+    RangeCoder::encode(ords, single, dict, []{});
+    for (const std::size_t statesCount: {2, 4, 8}) {
+        auto data = std::vector<std::byte>();
+        auto statesDict = TestDictionary(7, 1, 1);
+        const auto [wordsCount, bytesCount] = RangeCoder::encode(
+            ords, data, statesDict, []{}, statesCount);
+        EXPECT_EQ(wordsCount, ords.size());
+        EXPECT_EQ(bytesCount, data.size());
+        EXPECT_EQ(decodeAll(data, TestDictionary(7, 1, 1), ords.size(),
+                            statesCount),
+                  ords);
+        // Each state costs its final bytes only.
+        EXPECT_LE(data.size(), single.size() + 8 * statesCount);
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(RangeCoder, EncodeDecodeInterleavedShort) {
+    // Fewer words than states.
+    const auto ords = std::vector<std::uint64_t>{2, 0, 3};
+    auto data = std::vector<std::byte>();
+    auto dict = TestDictionary(4, 1, 1);
+    RangeCoder::encode(ords, data, dict, []{}, 8);
+    EXPECT_EQ(decodeAll(data, TestDictionary(4, 1, 1), ords.size(), 8), ords);
+}
+
+//----------------------------------------------------------------------------//
+TEST(RangeCoder, WrongStatesCount) {
+    auto data = std::vector<std::byte>();
+    auto dict = TestDictionary(4, 1, 1);
+    EXPECT_THROW(RangeCoder::encode(std::vector<std::uint64_t>{1}, data, dict,
+                                    []{}, 3),
+                 std::invalid_argument);
+}
+
+//----------------------------------------------------------------------------//
+TEST(RangeCoder, EncodeNothing) {
+    auto data = std::vector<std::byte>();
+    auto dict = TestDictionary(4, 1, 1);
+    const auto [wordsCount, bytesCount] =
+        RangeCoder::encode(std::vector<std::uint64_t>(), data, dict, []{});
+    EXPECT_EQ(wordsCount, 0);
+    EXPECT_EQ(bytesCount, data.size());
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <applib/rans_coder.hpp>
+
+namespace {
+
+//----------------------------------------------------------------------------//
+template <class OrdT>
+std::vector<OrdT> decodeAll(const std::vector<std::byte>& data,
+                            std::size_t wordsCount) {
+    auto ret = std::vector<OrdT>();
+    RansCoder::decode(data, std::back_inserter(ret), wordsCount, []{});
+    return ret;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------//
+TEST(RansCoder, EncodeDecodeSkewed) {
+    auto gen = std::mt19937(42);
+    auto distr = std::geometric_distribution<std::uint16_t>(0.3);
+    auto ords = std::vector<std::uint8_t>(100001);
+    for (auto& ord: ords) {
+        ord = static_cast<std::uint8_t>(
+            std::min<std::uint16_t>(distr(gen), 15));
+    }
+    auto data = std::vector<std::byte>();
+    const auto [wordsCount, bytesCount] =
+        RansCoder::encode(ords, data, []{});
+    EXPECT_EQ(wordsCount, ords.size());
+    EXPECT_EQ(bytesCount, data.size());
+    EXPECT_EQ(decodeAll<std::uint8_t>(data, ords.size()), ords);
+
+    // Entropy of geometric(0.3) is about 2.94 bits.
+    EXPECT_LT(data.size() * 8., 3.0 * ords.size());
+}
+
+//----------------------------------------------------------------------------//
+TEST(RansCoder, EncodeDecodeWideAlphabet) {
+    // More distinct words than the minimal scale, with a few of them taking
+    // most of the frame.
+    auto gen = std::mt19937(7);
+    auto distr = std::uniform_int_distribution<std::uint16_t>(0, 0xFFFF);
+    auto ords = std::vector<std::uint16_t>(200000);
+    for (std::size_t i = 0; i < ords.size(); ++i) {
+        ords[i] = i % 3 == 0 ? distr(gen) : static_cast<std::uint16_t>(i % 5);
+    }
+    auto data = std::vector<std::byte>();
+    RansCoder::encode(ords, data, []{});
+    EXPECT_EQ(decodeAll<std::uint16_t>(data, ords.size()), ords);
+}
+
+//----------------------------------------------------------------------------//
+TEST(RansCoder, EncodeDecodeSingleWord) {
+    const auto ords = std::vector<std::uint16_t>(1000, 0xFFFF);
+    auto data = std::vector<std::byte>();
+    RansCoder::encode(ords, data, []{});
+    EXPECT_EQ(decodeAll<std::uint16_t>(data, ords.size()), ords);
+}
+
+//----------------------------------------------------------------------------//
+TEST(RansCoder, EncodeDecodeShort) {
+    // Fewer words than states.
+    const auto ords = std::vector<std::uint8_t>{3, 1, 3};
+    auto data = std::vector<std::byte>();
+    RansCoder::encode(ords, data, []{});
+    EXPECT_EQ(decodeAll<std::uint8_t>(data, ords.size()), ords);
+
+    data.clear();
+    const auto [wordsCount, bytesCount] =
+        RansCoder::encode(std::vector<std::uint8_t>(), data, []{});
+    EXPECT_EQ(wordsCount, 0);
+    EXPECT_EQ(bytesCount, data.size());
+    EXPECT_TRUE(decodeAll<std::uint8_t>(data, 0).empty());
+}
+
+//----------------------------------------------------------------------------//
+TEST(RansCoder, DecodeWrongTable) {
+    auto data = std::vector<std::byte>();
+    RansCoder::encode(std::vector<std::uint8_t>{1, 2, 2}, data, []{});
+    // Frequency of the first word.
+    data[7] = std::byte{0};
+    EXPECT_THROW(decodeAll<std::uint8_t>(data, 3), std::runtime_error);
+    EXPECT_THROW(decodeAll<std::uint8_t>({std::byte{12}}, 3),
+                 std::runtime_error);
+}
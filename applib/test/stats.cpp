@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <applib/stats.hpp>
+
+//----------------------------------------------------------------------------//
+TEST(Stats, WriteJson) {
+    auto stats = Stats(true);
+    stats.addBytesIn(10);
+    stats.addBytesOut(20);
+    stats.addWords(5);
+    stats.setBitsPerWord(16);
+    {
+        auto timer = stats.time(Stats::Phase::Code);
+    }
+    auto out = std::ostringstream();
+    stats.writeJson("in\"file", "out", 1, out);
+    const auto json = out.str();
+    EXPECT_NE(json.find("\"in_file\": \"in\\\"file\""), std::string::npos);
+    EXPECT_NE(json.find("\"bytes_in\": 10,"), std::string::npos);
+    EXPECT_NE(json.find("\"bytes_out\": 20,"), std::string::npos);
+    EXPECT_NE(json.find("\"words\": 5,"), std::string::npos);
+    EXPECT_NE(json.find("\"bits_per_word\": 16,"), std::string::npos);
+    EXPECT_NE(json.find("\"code\": {\"wall_seconds\": "), std::string::npos);
+    EXPECT_EQ(json.back(), '\n');
+    EXPECT_EQ(json.find('\n'), json.size() - 1);
+}
+
+//----------------------------------------------------------------------------//
+TEST(Stats, WriteJsonEscapesControlCharacters) {
+    auto out = std::ostringstream();
+    Stats(true).writeJson("in\nfile\t\x1f", "out", 1, out);
+    const auto json = out.str();
+    EXPECT_NE(json.find("\"in_file\": \"in\\u000afile\\u0009\\u001f\""),
+              std::string::npos);
+    EXPECT_EQ(json.find('\n'), json.size() - 1);
+    EXPECT_EQ(json.find('\t'), std::string::npos);
+}
+
+//----------------------------------------------------------------------------//
+TEST(Stats, MeasureDictOnlyIfEnabled) {
+    auto madeCount = 0;
+    const auto makeDict = [&] {
+        ++madeCount;
+        return std::vector<int>(1 << 16);
+    };
+    auto offStats = Stats();
+    offStats.measureDict(makeDict);
+    EXPECT_EQ(madeCount, 0);
+    auto onStats = Stats(true);
+    onStats.measureDict(makeDict);
+    EXPECT_EQ(madeCount, 1);
+    // Heap of the process is not only the file's one.
+    auto sharedStats = Stats(true, false, false);
+    sharedStats.measureDict(makeDict);
+    EXPECT_EQ(madeCount, 1);
+}
+
+//----------------------------------------------------------------------------//
+TEST(Stats, ProcessMemoryOnlyIfExclusive) {
+    auto out = std::ostringstream();
+    Stats(true).writeJson("in", "out", 1, out);
+    EXPECT_EQ(out.str().find("null"), std::string::npos);
+
+    out.str({});
+    Stats(true, false, false).writeJson("in", "out", 1, out);
+    const auto json = out.str();
+    EXPECT_NE(json.find("\"dict_bytes\": null,"), std::string::npos);
+    EXPECT_NE(json.find("\"max_rss_kb\": null,"), std::string::npos);
+}
+
+//----------------------------------------------------------------------------//
+TEST(Stats, CpuSecondsOfPhases) {
+    auto stats = Stats(true);
+    {
+        auto timer = stats.time(Stats::Phase::Code);
+        // Some work to be timed.
+        volatile std::uint64_t sum = 0;
+        for (std::uint64_t i = 0; i < 10'000'000; ++i) {
+            sum = sum + i;
+        }
+    }
+    auto out = std::ostringstream();
+    stats.writeJson("in", "out", 1, out);
+    const auto json = out.str();
+    const auto cpuPos = json.find("\"cpu_seconds\": ") + 15;
+    const auto codePos = json.find("\"code\": {\"wall_seconds\": ");
+    const auto codeCpuPos = json.find("\"cpu_seconds\": ", codePos) + 15;
+    EXPECT_GT(std::stod(json.substr(cpuPos)), 0);
+    EXPECT_EQ(std::stod(json.substr(cpuPos)),
+              std::stod(json.substr(codeCpuPos)));
+}
+
+//----------------------------------------------------------------------------//
+TEST(Stats, PerfCountersInPhases) {
+    auto stats = Stats(true, true);
+    {
+        auto timer = stats.time(Stats::Phase::Split);
+    }
+    auto out = std::ostringstream();
+    stats.writeJson("in", "out", 1, out);
+    const auto json = out.str();
+    // Counters are null if they are not available, but always written.
+    EXPECT_NE(json.find("\"cycles\": "), std::string::npos);
+    EXPECT_NE(json.find("\"llc_misses\": "), std::string::npos);
+    EXPECT_NE(json.find("\"ipc\": "), std::string::npos);
+}
@@ -4,12 +4,11 @@
 
 #include <boost/program_options.hpp>
 
-#include <indicators/progress_bar.hpp>
-
-#include <ael/arithmetic_coder.hpp>
+#include <ael/byte_data_constructor.hpp>
 #include <ael/dictionary/adaptive_a_contextual_dictionary.hpp>
 
-#include <applib/ord_and_tail_splitter.hpp>
+#include <applib/batch_impl.hpp>
+#include <applib/encode_impl.hpp>
 #include <applib/file_opener.hpp>
 #include <applib/log_stream_get.hpp>
 
@@ -18,23 +17,15 @@ namespace bpo = boost::program_options;
 int main(int argc, char* argv[]) {
     bpo::options_description appOptionsDescr("Console options.");
 
-    std::string inFileName;
-    std::string outFileName;
+    BatchImpl::Options batchOptions;
     std::uint16_t numBits;
     std::uint16_t ctxCellsCnt;
     std::uint16_t ctxCellLength;
+    EncodeImpl::Options encodeOptions;
     std::string logStreamParam;
 
     try {
         appOptionsDescr.add_options() (
-                "input-file,i",
-                bpo::value(&inFileName)->required(),
-                "In file name."
-            ) (
-                "out-filename,o",
-                bpo::value(&outFileName)->default_value({}),
-                "Out file name."
-            ) (
                 "bits,b",
                 bpo::value(&numBits)->default_value(16),
                 "Word bits count."
@@ -52,36 +43,32 @@ int main(int argc, char* argv[]) {
                 "Log stream."
             );
 
+        BatchImpl::addOptions(appOptionsDescr, batchOptions);
+        EncodeImpl::addOptions(appOptionsDescr, encodeOptions);
+
         bpo::variables_map vm;
-        bpo::store(bpo::parse_command_line(argc, argv, appOptionsDescr), vm);
+        BatchImpl::store(argc, argv, appOptionsDescr, vm);
         bpo::notify(vm);
 
-        outFileName = outFileName.empty() ? inFileName + "-encoded" : outFileName;
         auto& outStream = LogStreamGet::getLogStream(logStreamParam);
-        auto fileOpener = FileOpener(inFileName, outFileName, outStream);
-        auto dict = ael::dict::AdaptiveAContextualDictionary(numBits, ctxCellsCnt, ctxCellLength);
-
-        auto [wordsOrds, tail] = OrdAndTailSplitter::process(fileOpener.getInData(), numBits);
+        const auto jobs = BatchImpl::makeJobs(batchOptions, "-encoded");
+        BatchImpl::run(jobs, batchOptions, outStream,
+                       [&](const BatchImpl::Job& job,
+                           std::ostream& logStream,
+                           Stats& stats) {
+            auto fileOpener = FileOpener(job.inFileName, job.outFileName,
+                                         logStream, stats);
+            const auto makeDict = [&] {
+                return ael::dict::AdaptiveAContextualDictionary(numBits, ctxCellsCnt, ctxCellLength);
+            };
 
-        auto encoded = ael::ByteDataConstructor();
-        encoded.putT<std::uint16_t>(numBits);
-        encoded.putT<std::uint16_t>(tail.size());
-        encoded.putT<std::uint8_t>(ctxCellsCnt);
-        encoded.putT<std::uint8_t>(ctxCellLength);
-        const auto wordsCountPos = encoded.saveSpaceForT<std::uint64_t>();
-        const auto bitsCountPos = encoded.saveSpaceForT<std::uint64_t>();
-        auto progressBar = indicators::ProgressBar(
-            indicators::option::BarWidth{50},
-            indicators::option::MaxProgress{wordsOrds.size()},
-            indicators::option::ShowPercentage{true},
-            indicators::option::PostfixText{"Encoding"},
-            indicators::option::Stream{outStream});
-        auto [wordsCount, bitsCount] = ael::ArithmeticCoder::encode(
-            wordsOrds, encoded, dict, [&progressBar](){ progressBar.tick(); });
-        encoded.putTToPosition(wordsCount, wordsCountPos);
-        encoded.putTToPosition(bitsCount, bitsCountPos);
-        std::copy(tail.begin(), tail.end(), encoded.getBitBackInserter());
-        fileOpener.getOutFileStream().write(encoded.data<char>(), encoded.size());
+            auto header = ael::ByteDataConstructor();
+            header.putT<std::uint16_t>(numBits);
+            header.putT<std::uint8_t>(ctxCellsCnt);
+            header.putT<std::uint8_t>(ctxCellLength);
+            EncodeImpl::process(fileOpener, makeDict, numBits, encodeOptions,
+                                std::move(header), logStream, stats);
+        });
     } catch (const std::exception& error) {
         std::cerr << error.what() << std::endl;
         return 1;
@@ -4,30 +4,52 @@
 
 #include <ael/dictionary/adaptive_dictionary.hpp>
 
-#include <applib/file_opener.hpp>
+#include <applib/batch_impl.hpp>
 #include <applib/decode_impl.hpp>
+#include <applib/dictionary_kind.hpp>
+#include <applib/fenwick_dictionary.hpp>
+#include <applib/file_opener.hpp>
 
 //----------------------------------------------------------------------------//
 int main(int argc, char* argv[]) {
     try {
         auto cfg = DecodeImpl::configure(argc, argv);
 
-        const auto takeWithLog = [&]<class T>(const std::string& msg, T) {    
-            const auto ret = cfg.decoded.takeT<T>();
-            cfg.outStream << msg << static_cast<std::int64_t>(ret) << std::endl;
-            return ret;
-        };
-
-        const auto symBitLen = takeWithLog("Word bits length: ", std::uint16_t{});
-        const auto tailSize = takeWithLog("Tail size: ", std::uint16_t{});
-        const auto ratio = takeWithLog("Words count: ", std::uint64_t{});
-        const auto wordsCount = takeWithLog("Words count: ", std::uint64_t{});
-        const auto bitsCount = takeWithLog("Bits count: ", std::uint64_t{});
-
-        auto dict = ael::dict::AdaptiveDictionary(1 << bitsCount, ratio);
-
-        DecodeImpl::process(cfg.decoded, dict, wordsCount, bitsCount, symBitLen, tailSize,
-                            cfg.fileOpener.getOutFileStream(), cfg.outStream);
+        BatchImpl::run(cfg.jobs, cfg.batchOptions, cfg.outStream,
+                       [&](const BatchImpl::Job& job,
+                           std::ostream& logStream,
+                           Stats& stats) {
+            auto file = DecodeImpl::openFile(job, logStream, stats);
+
+            const auto takeWithLog = [&]<class T>(const std::string& msg, T) {    
+                const auto ret = file.decoded.takeT<T>();
+                file.outStream << msg << static_cast<std::int64_t>(ret) << std::endl;
+                return ret;
+            };
+
+            const auto symBitLen = takeWithLog("Word bits length: ", std::uint16_t{});
+            const auto ratio = takeWithLog("Dictionary ratio: ", std::uint64_t{});
+
+            const auto dictionaryKind = takeDictionaryKind(
+                file.decoded.takeT<std::uint8_t>(), symBitLen);
+            file.outStream << "Dictionary: " << dictionaryKind << std::endl;
+
+            const auto process = [&](auto makeDict) {
+                DecodeImpl::process(file.fileOpener.getInData(), makeDict,
+                                    symBitLen, cfg.options, file.fileOpener,
+                                    file.outStream, stats);
+            };
+            if (dictionaryKind == DictionaryKind::Fenwick) {
+                process([&] {
+                    return FenwickDictionary(1ull << symBitLen, ratio);
+                });
+            } else {
+                process([&] {
+                    return ael::dict::AdaptiveDictionary(1ull << symBitLen,
+                                                         ratio);
+                });
+            }
+        });
     } catch (const std::runtime_error&  error) {
         std::cerr << error.what();
         return 1;
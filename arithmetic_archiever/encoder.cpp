@@ -4,12 +4,13 @@
 
 #include <boost/program_options.hpp>
 
-#include <indicators/progress_bar.hpp>
-
-#include <ael/arithmetic_coder.hpp>
+#include <ael/byte_data_constructor.hpp>
 #include <ael/dictionary/adaptive_dictionary.hpp>
 
-#include <applib/ord_and_tail_splitter.hpp>
+#include <applib/batch_impl.hpp>
+#include <applib/dictionary_kind.hpp>
+#include <applib/encode_impl.hpp>
+#include <applib/fenwick_dictionary.hpp>
 #include <applib/file_opener.hpp>
 #include <applib/log_stream_get.hpp>
 
@@ -18,22 +19,15 @@ namespace bpo = boost::program_options;
 int main(int argc, char* argv[]) {
     bpo::options_description appOptionsDescr("Console options.");
 
-    std::string inFileName;
-    std::string outFileName;
+    BatchImpl::Options batchOptions;
     std::uint16_t numBits;
     std::uint64_t ratio;
+    EncodeImpl::Options encodeOptions;
     std::string logStreamParam;
+    DictionaryKind dictionaryKind;
 
     try {
         appOptionsDescr.add_options() (
-                "input-file,i",
-                bpo::value(&inFileName)->required(),
-                "In file name."
-            ) (
-                "out-filename,o",
-                bpo::value(&outFileName)->default_value({}),
-                "Out file name."
-            ) (
                 "bits,b",
                 bpo::value(&numBits)->default_value(16),
                 "Word bits count."
@@ -45,38 +39,56 @@ int main(int argc, char* argv[]) {
                 "log-stream,l",
                 bpo::value(&logStreamParam)->default_value("stdout"),
                 "Log stream."
+            ) (
+                "dictionary",
+                bpo::value(&dictionaryKind)->default_value(
+                    DictionaryKind::SegmentTree),
+                "Dictionary counts structure: \"segment-tree\" or "
+                "\"fenwick\" (faster, up to 16 bits)."
             );
 
+        BatchImpl::addOptions(appOptionsDescr, batchOptions);
+        EncodeImpl::addOptions(appOptionsDescr, encodeOptions);
+
         bpo::variables_map vm;
-        bpo::store(bpo::parse_command_line(argc, argv, appOptionsDescr), vm);
+        BatchImpl::store(argc, argv, appOptionsDescr, vm);
         bpo::notify(vm);
 
-        outFileName = outFileName.empty() ? inFileName + "-encoded" : outFileName;
-        
-        auto& outStream = LogStreamGet::getLogStream(logStreamParam);
-        auto fileOpener = FileOpener(inFileName, outFileName, outStream);
-        auto dict = ael::dict::AdaptiveDictionary(1ull << numBits, ratio);
-
-        auto [wordsOrds, tail] = OrdAndTailSplitter::process(fileOpener.getInData(), numBits);
+        if (dictionaryKind == DictionaryKind::Fenwick
+                && numBits > fenwickMaxWordBits) {
+            throw std::runtime_error("Fenwick dictionary takes words up to "
+                                     "16 bits.");
+        }
 
-        auto coder = ael::ArithmeticCoder();
-        auto encoded = ael::ByteDataConstructor();
-        encoded.putT<std::uint16_t>(numBits);
-        encoded.putT<std::uint16_t>(tail.size());
-        const auto wordsCountPos = encoded.saveSpaceForT<std::uint64_t>();
-        const auto bitsCountPos = encoded.saveSpaceForT<std::uint64_t>();
-        auto progressBar = indicators::ProgressBar(
-            indicators::option::BarWidth{50},
-            indicators::option::MaxProgress{wordsOrds.size()},
-            indicators::option::ShowPercentage{true},
-            indicators::option::PostfixText{"Encoding"},
-            indicators::option::Stream{outStream});
-        auto [wordsCount, bitsCount] = ael::ArithmeticCoder::encode(
-            wordsOrds, encoded, dict, [&progressBar]() { progressBar.tick(); });
-        encoded.putTToPosition(wordsCount, wordsCountPos);
-        encoded.putTToPosition(bitsCount, bitsCountPos);
-        std::copy(tail.begin(), tail.end(), encoded.getBitBackInserter());
-        fileOpener.getOutFileStream().write(encoded.data<char>(), encoded.size());
+        auto& outStream = LogStreamGet::getLogStream(logStreamParam);
+        const auto jobs = BatchImpl::makeJobs(batchOptions, "-encoded");
+        BatchImpl::run(jobs, batchOptions, outStream,
+                       [&](const BatchImpl::Job& job,
+                           std::ostream& logStream,
+                           Stats& stats) {
+            auto fileOpener = FileOpener(job.inFileName, job.outFileName,
+                                         logStream, stats);
+            auto header = ael::ByteDataConstructor();
+            header.putT<std::uint16_t>(numBits);
+            header.putT<std::uint64_t>(ratio);
+            header.putT<std::uint8_t>(
+                static_cast<std::uint8_t>(dictionaryKind));
+            const auto process = [&](auto makeDict) {
+                EncodeImpl::process(fileOpener, makeDict, numBits,
+                                    encodeOptions, std::move(header),
+                                    logStream, stats);
+            };
+            if (dictionaryKind == DictionaryKind::Fenwick) {
+                process([&] {
+                    return FenwickDictionary(1ull << numBits, ratio);
+                });
+            } else {
+                process([&] {
+                    return ael::dict::AdaptiveDictionary(1ull << numBits,
+                                                         ratio);
+                });
+            }
+        });
     } catch (const std::runtime_error& error) {
         std::cerr << error.what() << std::endl;
         return 2;
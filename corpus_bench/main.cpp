@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <fmt/format.h>
+
+#include "report.hpp"
+#include "run_process.hpp"
+
+namespace bpo = boost::program_options;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct ArchieverPair {
+    std::string name;
+    std::string encoder;
+    std::string decoder;
+};
+
+struct MatrixRow {
+    std::string archiever;
+    std::vector<std::string> params;
+};
+
+// Paths of built executables, generated by CMake.
+const auto archieverPairs = std::vector<ArchieverPair>{
+#include "archievers_pairs.inc"
+};
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> splitParams(const std::string& line) {
+    auto stream = std::istringstream(line);
+    auto ret = std::vector<std::string>();
+    for (std::string param; stream >> param;) {
+        ret.push_back(param);
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string joinParams(const std::vector<std::string>& params) {
+    auto ret = std::string();
+    for (const auto& param: params) {
+        ret += (ret.empty() ? "" : " ") + param;
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Default matrix: 8 and 16 bits words for every archiever with words.
+std::vector<MatrixRow> makeDefaultMatrix() {
+    auto ret = std::vector<MatrixRow>();
+    for (const auto& pair: archieverPairs) {
+        if (pair.name == "numerical") {
+            ret.push_back({pair.name, {}});
+        } else {
+            ret.push_back({pair.name, {"-b", "8"}});
+            ret.push_back({pair.name, {"-b", "16"}});
+        }
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Matrix file: "<archiever> <encoder params...>" per line, # for comments.
+std::vector<MatrixRow> readMatrix(const std::string& fileName) {
+    auto file = std::ifstream(fileName);
+    if (!file) {
+        throw std::runtime_error(
+            fmt::format("Could not open matrix {}.", fileName));
+    }
+    auto ret = std::vector<MatrixRow>();
+    for (std::string line; std::getline(file, line);) {
+        auto params = splitParams(line.substr(0, line.find('#')));
+        if (!params.empty()) {
+            auto archiever = params.front();
+            params.erase(params.begin());
+            ret.push_back({std::move(archiever), std::move(params)});
+        }
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const ArchieverPair& findPair(const std::string& name) {
+    const auto it = std::find_if(archieverPairs.begin(), archieverPairs.end(),
+                                 [&](const ArchieverPair& pair) {
+                                     return pair.name == name;
+                                 });
+    if (it == archieverPairs.end()) {
+        throw std::runtime_error(fmt::format("Unknown archiever {}.", name));
+    }
+    return *it;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool filesEqual(const fs::path& left, const fs::path& right) {
+    auto leftStream = std::ifstream(left, std::ios::binary);
+    auto rightStream = std::ifstream(right, std::ios::binary);
+    if (!leftStream || !rightStream) {
+        return false;
+    }
+    constexpr std::size_t buffSize = 1 << 16;
+    auto leftBuff = std::vector<char>(buffSize);
+    auto rightBuff = std::vector<char>(buffSize);
+    while (leftStream && rightStream) {
+        leftStream.read(leftBuff.data(), buffSize);
+        rightStream.read(rightBuff.data(), buffSize);
+        if (leftStream.gcount() != rightStream.gcount()
+                || !std::equal(leftBuff.begin(),
+                               leftBuff.begin() + leftStream.gcount(),
+                               rightBuff.begin())) {
+            return false;
+        }
+    }
+    return leftStream.eof() && rightStream.eof();
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------//
+int main(int argc, char* argv[]) {
+    bpo::options_description appOptionsDescr("Console options.");
+
+    std::string corpusDirName;
+    std::string workDirName;
+    std::string matrixFileName;
+    std::vector<std::string> archieversNames;
+    std::string format;
+    std::string outFileName;
+
+    try {
+        appOptionsDescr.add_options() (
+            "corpus-dir,d",
+            bpo::value(&corpusDirName)->required(),
+            "Directory with files to compress."
+        ) (
+            "work-dir,w",
+            bpo::value(&workDirName)->default_value("corpus_bench_work"),
+            "Directory for encoded and decoded files."
+        ) (
+            "matrix,m",
+            bpo::value(&matrixFileName)->default_value({}),
+            "File with \"<archiever> <encoder params...>\" lines."
+        ) (
+            "archievers,a",
+            bpo::value(&archieversNames)->multitoken(),
+            "Run only these archievers."
+        ) (
+            "format,f",
+            bpo::value(&format)->default_value("json"),
+            "Report format: json or csv."
+        ) (
+            "out-filename,o",
+            bpo::value(&outFileName)->default_value({}),
+            "Report file name. Standard output if not set."
+        );
+
+        bpo::variables_map vm;
+        bpo::store(bpo::parse_command_line(argc, argv, appOptionsDescr), vm);
+        bpo::notify(vm);
+
+        if (format != "json" && format != "csv") {
+            throw std::runtime_error(
+                fmt::format("{} is invalid report format.", format));
+        }
+
+        auto matrix = matrixFileName.empty()
+            ? makeDefaultMatrix()
+            : readMatrix(matrixFileName);
+        if (!archieversNames.empty()) {
+            std::erase_if(matrix, [&](const MatrixRow& row) {
+                return std::find(archieversNames.begin(),
+                                 archieversNames.end(),
+                                 row.archiever) == archieversNames.end();
+            });
+        }
+
+        auto fileNames = std::vector<fs::path>();
+        for (const auto& entry: fs::directory_iterator(corpusDirName)) {
+            if (entry.is_regular_file()) {
+                fileNames.push_back(entry.path());
+            }
+        }
+        std::sort(fileNames.begin(), fileNames.end());
+
+        fs::create_directories(workDirName);
+        const auto encodedFileName = fs::path(workDirName) / "encoded";
+        const auto decodedFileName = fs::path(workDirName) / "decoded";
+
+        auto report = Report();
+        for (const auto& row: matrix) {
+            const auto& pair = findPair(row.archiever);
+            for (const auto& fileName: fileNames) {
+                std::cerr << row.archiever << " " << joinParams(row.params)
+                          << " " << fileName.filename().string() << std::endl;
+
+                auto encodeArgs = std::vector<std::string>{
+                    pair.encoder, "-i", fileName.string(),
+                    "-o", encodedFileName.string(), "-l", "off"};
+                encodeArgs.insert(encodeArgs.end(),
+                                  row.params.begin(), row.params.end());
+                const auto encodeRet = ProcessRunner::run(encodeArgs);
+
+                const auto decodeRet = ProcessRunner::run({
+                    pair.decoder, "-i", encodedFileName.string(),
+                    "-o", decodedFileName.string(), "-l", "off"});
+
+                auto error = std::error_code();
+                const auto compressedSize =
+                    fs::file_size(encodedFileName, error);
+
+                report.add({
+                    row.archiever,
+                    joinParams(row.params),
+                    fileName.filename().string(),
+                    fs::file_size(fileName),
+                    error ? 0 : compressedSize,
+                    encodeRet.seconds,
+                    decodeRet.seconds,
+                    encodeRet.maxRssKb,
+                    decodeRet.maxRssKb,
+                    encodeRet.exitCode == 0 && decodeRet.exitCode == 0
+                        && filesEqual(fileName, decodedFileName)
+                });
+
+                fs::remove(encodedFileName, error);
+                fs::remove(decodedFileName, error);
+            }
+        }
+
+        auto outFile = std::ofstream();
+        if (!outFileName.empty()) {
+            outFile.open(outFileName);
+        }
+        auto& out = outFileName.empty() ? std::cout : outFile;
+        if (format == "json") {
+            report.writeJson(out);
+        } else {
+            report.writeCsv(out);
+        }
+
+        if (const auto failedCount = report.failedCount(); failedCount != 0) {
+            std::cerr << failedCount << " runs failed." << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 2;
+    }
+
+    return 0;
+}
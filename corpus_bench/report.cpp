@@ -0,0 +1,96 @@
+#include "report.hpp"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+double megabytesPerSecond(std::uint64_t bytes, double seconds) {
+    return seconds > 0 ? static_cast<double>(bytes) / 1e6 / seconds : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string escapeJson(const std::string& str) {
+    auto ret = std::string();
+    for (char c: str) {
+        if (c == '"' || c == '\\') {
+            ret.push_back('\\');
+        }
+        ret.push_back(c);
+    }
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string escapeCsv(const std::string& str) {
+    if (str.find_first_of(",\"") == std::string::npos) {
+        return str;
+    }
+    auto ret = std::string("\"");
+    for (char c: str) {
+        if (c == '"') {
+            ret.push_back('"');
+        }
+        ret.push_back(c);
+    }
+    return ret + "\"";
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t Report::failedCount() const {
+    return std::count_if(_records.begin(), _records.end(),
+                         [](const Record& record) {
+                             return !record.roundTripOk;
+                         });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Report::writeJson(std::ostream& os) const {
+    os << "[\n";
+    for (std::size_t i = 0; i < _records.size(); ++i) {
+        const auto& r = _records[i];
+        os << fmt::format(
+            "  {{\"archiever\": \"{}\", \"params\": \"{}\", \"file\": \"{}\", "
+            "\"original_size\": {}, \"compressed_size\": {}, "
+            "\"ratio\": {:.4f}, "
+            "\"encode_seconds\": {:.4f}, \"decode_seconds\": {:.4f}, "
+            "\"encode_mb_s\": {:.2f}, \"decode_mb_s\": {:.2f}, "
+            "\"encode_max_rss_kb\": {}, \"decode_max_rss_kb\": {}, "
+            "\"round_trip_ok\": {}}}{}\n",
+            escapeJson(r.archiever), escapeJson(r.params),
+            escapeJson(r.fileName), r.originalSize, r.compressedSize,
+            r.originalSize ? static_cast<double>(r.compressedSize)
+                                 / static_cast<double>(r.originalSize) : 0.,
+            r.encodeSeconds, r.decodeSeconds,
+            megabytesPerSecond(r.originalSize, r.encodeSeconds),
+            megabytesPerSecond(r.originalSize, r.decodeSeconds),
+            r.encodeMaxRssKb, r.decodeMaxRssKb,
+            r.roundTripOk ? "true" : "false",
+            i + 1 == _records.size() ? "" : ",");
+    }
+    os << "]\n";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Report::writeCsv(std::ostream& os) const {
+    os << "archiever,params,file,original_size,compressed_size,ratio,"
+          "encode_seconds,decode_seconds,encode_mb_s,decode_mb_s,"
+          "encode_max_rss_kb,decode_max_rss_kb,round_trip_ok\n";
+    for (const auto& r: _records) {
+        os << fmt::format(
+            "{},{},{},{},{},{:.4f},{:.4f},{:.4f},{:.2f},{:.2f},{},{},{}\n",
+            escapeCsv(r.archiever), escapeCsv(r.params),
+            escapeCsv(r.fileName), r.originalSize, r.compressedSize,
+            r.originalSize ? static_cast<double>(r.compressedSize)
+                                 / static_cast<double>(r.originalSize) : 0.,
+            r.encodeSeconds, r.decodeSeconds,
+            megabytesPerSecond(r.originalSize, r.encodeSeconds),
+            megabytesPerSecond(r.originalSize, r.decodeSeconds),
+            r.encodeMaxRssKb, r.decodeMaxRssKb,
+            r.roundTripOk ? 1 : 0);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef CORPUS_BENCH_REPORT_HPP
+#define CORPUS_BENCH_REPORT_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The Report class. Results of encoder/decoder runs, written as JSON
+/// or CSV with one record per line, so reports of two builds can be diffed.
+///
+class Report {
+public:
+    struct Record {
+        std::string archiever;
+        std::string params;
+        std::string fileName;
+        std::uint64_t originalSize;
+        std::uint64_t compressedSize;
+        double encodeSeconds;
+        double decodeSeconds;
+        std::uint64_t encodeMaxRssKb;
+        std::uint64_t decodeMaxRssKb;
+        bool roundTripOk;
+    };
+
+public:
+
+    /**
+     * @brief add - add run record.
+     * @param record - record to add.
+     */
+    void add(Record record) { _records.push_back(std::move(record)); }
+
+    /**
+     * @brief failedCount - get number of runs which did not round trip.
+     * @return failed runs count.
+     */
+    std::size_t failedCount() const;
+
+    /**
+     * @brief writeJson - write records as JSON array.
+     * @param os - stream to write to.
+     */
+    void writeJson(std::ostream& os) const;
+
+    /**
+     * @brief writeCsv - write records as CSV with header.
+     * @param os - stream to write to.
+     */
+    void writeCsv(std::ostream& os) const;
+
+private:
+    std::vector<Record> _records;
+};
+
+#endif  // CORPUS_BENCH_REPORT_HPP
@@ -0,0 +1,49 @@
+#include "run_process.hpp"
+
+#include <chrono>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#if __has_include(<sys/wait.h>)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define CORPUS_BENCH_HAS_FORK
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+auto ProcessRunner::run(const std::vector<std::string>& args) -> Ret {
+#ifdef CORPUS_BENCH_HAS_FORK
+    auto argv = std::vector<char*>();
+    for (const auto& arg: args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto pid = ::fork();
+    if (pid < 0) {
+        throw std::runtime_error("Could not fork.");
+    }
+    if (pid == 0) {
+        ::execv(argv[0], argv.data());
+        ::_exit(127);
+    }
+
+    int status = 0;
+    struct rusage usage {};
+    if (::wait4(pid, &status, 0, &usage) < 0) {
+        throw std::runtime_error(fmt::format("Could not wait for {}.", args[0]));
+    }
+    const auto finish = std::chrono::steady_clock::now();
+
+    return {
+        WIFEXITED(status) ? WEXITSTATUS(status) : -1,
+        std::chrono::duration<double>(finish - start).count(),
+        static_cast<std::uint64_t>(usage.ru_maxrss)  // Kilobytes on Linux.
+    };
+#else
+    throw std::runtime_error("Running processes is not supported.");
+#endif
+}
@@ -0,0 +1,28 @@
+#ifndef CORPUS_BENCH_RUN_PROCESS_HPP
+#define CORPUS_BENCH_RUN_PROCESS_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The ProcessRunner class. Runs an executable and measures its wall
+/// time and peak resident memory.
+///
+class ProcessRunner {
+public:
+    struct Ret {
+        int exitCode;
+        double seconds;
+        std::uint64_t maxRssKb;
+    };
+
+    /**
+     * @brief run - run executable and wait for it.
+     * @param args - executable path and its arguments.
+     * @return exit code and measurements.
+     */
+    static Ret run(const std::vector<std::string>& args);
+};
+
+#endif  // CORPUS_BENCH_RUN_PROCESS_HPP
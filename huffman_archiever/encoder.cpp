@@ -0,0 +1,8 @@
+#include <applib/huffman_coder.hpp>
+#include <applib/semi_static_impl.hpp>
+
+//----------------------------------------------------------------------------//
+int main(int argc, char* argv[]) {
+    return SemiStaticImpl::encode<HuffmanCoder>(argc, argv,
+                                                FramesLayout::Coder::Huffman);
+}
@@ -1,83 +1,91 @@
 #include <cstdint>
 #include <iostream>
 #include <iterator>
+#include <vector>
 
 #include <boost/program_options.hpp>
 
-#include <indicators/progress_bar.hpp>
-
 #include <ael/numerical_decoder.hpp>
 #include <ael/data_parser.hpp>
-#include <ael/byte_data_constructor.hpp>
 
-#include <applib/file_opener.hpp>
+#include <applib/batch_impl.hpp>
+#include <applib/bits_writer.hpp>
 #include <applib/decode_impl.hpp>
-#include <applib/word/bytes_word.hpp>
+#include <applib/file_opener.hpp>
+#include <applib/progress_meter.hpp>
 
 int main(int argc, char* argv[]) {
     try {
         auto cfg =
             DecodeImpl::configure(argc, argv);
 
-        const auto takeWithLog = [&]<class T>(const std::string& msg, T) {    
-            const auto ret = cfg.decoded.takeT<T>();
-            cfg.outStream << msg << static_cast<std::int64_t>(ret) << std::endl;
-            return ret;
-        };
-
-        const auto dictSize =
-            takeWithLog("Dictionary size: ", std::uint64_t{});
-        const auto wordsBitsCnt =
-            takeWithLog("Bits count for dictionary words decoding: ", std::uint64_t{});
-        const auto wordsCountsBitsCnt =
-            takeWithLog("Bits count for words counts decoding: ", std::uint64_t{});
-        const auto contentWordsCnt =
-            takeWithLog("Content words number: ", std::uint64_t{});
-        const auto contentBitsCnt =
-            takeWithLog("Bits for content decoding: ", std::uint64_t{});
+        BatchImpl::run(cfg.jobs, cfg.batchOptions, cfg.outStream,
+                       [&](const BatchImpl::Job& job,
+                           std::ostream& logStream,
+                           Stats& stats) {
+            auto file = DecodeImpl::openFile(job, logStream, stats);
 
-        auto contentWordsOrds = std::vector<std::uint64_t>();
-        const auto layoutInfo = ael::NumericalDecoder::LayoutInfo {
-            dictSize, wordsCountsBitsCnt, wordsBitsCnt, contentWordsCnt, contentBitsCnt
-        };
-        auto wordsProgressBar = indicators::ProgressBar(
-            indicators::option::BarWidth{50},
-            indicators::option::MaxProgress{layoutInfo.dictWordsCount},
-            indicators::option::ShowPercentage{true},
-            indicators::option::PostfixText{"Decoding words"},
-            indicators::option::Stream{cfg.outStream}
-        );
-        auto countsProgressBar = indicators::ProgressBar(
-            indicators::option::BarWidth{50},
-            indicators::option::MaxProgress{layoutInfo.dictWordsCount},
-            indicators::option::ShowPercentage{true},
-            indicators::option::PostfixText{"Decoding counts"},
-            indicators::option::Stream{cfg.outStream}
-        );
-        auto contentProgressBar = indicators::ProgressBar(
-            indicators::option::BarWidth{50},
-            indicators::option::MaxProgress{layoutInfo.contentWordsCount},
-            indicators::option::ShowPercentage{true},
-            indicators::option::PostfixText{"Decoding content"},
-            indicators::option::Stream{cfg.outStream}
-        );
-        ael::NumericalDecoder::decode(
-            cfg.decoded, std::back_inserter(contentWordsOrds), 256,
-            layoutInfo,
-            [&wordsProgressBar]{ wordsProgressBar.tick(); },
-            [&countsProgressBar]{ countsProgressBar.tick(); },
-            [&contentProgressBar]{ contentProgressBar.tick(); });
+            const auto takeWithLog = [&]<class T>(const std::string& msg, T) {    
+                const auto ret = file.decoded.takeT<T>();
+                file.outStream << msg << static_cast<std::int64_t>(ret) << std::endl;
+                return ret;
+            };
 
-        auto dataConstructor = ael::ByteDataConstructor();
+            const auto dictSize =
+                takeWithLog("Dictionary size: ", std::uint64_t{});
+            const auto wordsBitsCnt =
+                takeWithLog("Bits count for dictionary words decoding: ", std::uint64_t{});
+            const auto wordsCountsBitsCnt =
+                takeWithLog("Bits count for words counts decoding: ", std::uint64_t{});
+            const auto contentWordsCnt =
+                takeWithLog("Content words number: ", std::uint64_t{});
+            const auto contentBitsCnt =
+                takeWithLog("Bits for content decoding: ", std::uint64_t{});
 
-        for (auto& wordOrd: contentWordsOrds) {
-            auto word = BytesWord<1>::byOrd(wordOrd);
-            word.bytesOut(dataConstructor.getByteBackInserter());
-        }
+            const auto layoutInfo = ael::NumericalDecoder::LayoutInfo {
+                dictSize, wordsCountsBitsCnt, wordsBitsCnt, contentWordsCnt, contentBitsCnt
+            };
+            auto wordsProgress = ProgressMeter(
+                file.outStream, "Decoding words",
+                layoutInfo.dictWordsCount, 0);
+            auto countsProgress = ProgressMeter(
+                file.outStream, "Decoding counts",
+                layoutInfo.dictWordsCount, 0);
+            auto contentProgress = ProgressMeter(
+                file.outStream, "Decoding content",
+                layoutInfo.contentWordsCount, 1);
 
-        cfg.fileOpener.getOutFileStream().write(
-                    dataConstructor.data<char>(), dataConstructor.size());
+            // One byte per word: content is decoded right into the mapped
+            // output file, or into a buffer for streams.
+            auto outBuffer = std::vector<std::byte>();
+            auto outData = file.fileOpener.mapOutData(contentWordsCnt);
+            if (outData.empty()) {
+                outBuffer.resize(contentWordsCnt);
+                outData = outBuffer;
+            }
+            auto writer = BitsWriter(outData);
+            auto contentWordsOrds = std::vector<std::uint8_t>();
+            DecodeImpl::packDecoded([&](auto ordsOut) {
+                ael::NumericalDecoder::decode(
+                    file.decoded, ordsOut, 256,
+                    layoutInfo,
+                    wordsProgress.getTick(),
+                    countsProgress.getTick(),
+                    contentProgress.getTick());
+            }, contentWordsOrds, contentWordsCnt, writer, 8, stats);
+            writer.finish();
+            stats.addWords(contentWordsCnt);
+            stats.setBitsPerWord(8);
+            wordsProgress.finish();
+            countsProgress.finish();
+            contentProgress.finish();
 
+            auto timer = stats.time(Stats::Phase::Write);
+            file.fileOpener.getOutFileStream().write(
+                        reinterpret_cast<const char*>(outBuffer.data()),
+                        outBuffer.size());
+            stats.addBytesOut(contentWordsCnt);
+        });
     } catch (const std::exception&  error) {
         std::cerr << error.what();
         return 1;
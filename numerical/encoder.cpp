@@ -4,16 +4,16 @@
 #include <boost/program_options.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
-#include <indicators/progress_bar.hpp>
-
 #include <ael/numerical_coder.hpp>
 #include <ael/dictionary/decreasing_counts_dictionary.hpp>
 #include <ael/dictionary/decreasing_on_update_dictionary.hpp>
 
+#include <applib/batch_impl.hpp>
 #include <applib/flow/bytes_word_flow.hpp>
 #include <applib/ord_and_tail_splitter.hpp>
 #include <applib/file_opener.hpp>
 #include <applib/log_stream_get.hpp>
+#include <applib/progress_meter.hpp>
 
 namespace bpo = boost::program_options;
 
@@ -26,95 +26,86 @@ using DictWordsFlow = std::vector<BytesWord<1>>;
 int main(int argc, char* argv[]) {
     bpo::options_description appOptionsDescr("Console options.");
 
-    std::string inFileName;
-    std::string outFileName;
+    BatchImpl::Options batchOptions;
     std::string logStreamParam;
 
     try {
         appOptionsDescr.add_options() (
-            "input-file,i",
-            bpo::value(&inFileName)->required(),
-            "In file name."
-        ) (
-            "out-filename,o",
-            bpo::value(&outFileName)->default_value({}),
-            "Out file name."
-        ) (
             "log-stream,l",
             bpo::value(&logStreamParam)->default_value("stdout"),
             "Log stream."
         );
 
+        BatchImpl::addOptions(appOptionsDescr, batchOptions);
+
         bpo::variables_map vm;
-        bpo::store(bpo::parse_command_line(argc, argv, appOptionsDescr), vm);
+        BatchImpl::store(argc, argv, appOptionsDescr, vm);
         bpo::notify(vm);
 
-        outFileName = outFileName.empty() ? inFileName + "-encoded" : outFileName;
         auto& outStream = LogStreamGet::getLogStream(logStreamParam);
-        auto fileOpener = FileOpener(inFileName, outFileName, outStream);
-        auto inFileBytes = fileOpener.getInData();
-        auto wordFlow = BytesWordFlow<1>(inFileBytes);
-
-        auto ordFlow = std::vector<std::uint64_t>();
-
-        std::transform(wordFlow.begin(), wordFlow.end(), 
-                       std::back_inserter(ordFlow),
-                       [](const auto& word) {
-                           return BytesWord<1>::ord(word);
-                       });
-
-        auto dataConstructor = ael::ByteDataConstructor();        
-
-        const auto dictSizePos = dataConstructor.saveSpaceForT<std::uint64_t>();
-        const auto wordsBitsCntPos = dataConstructor.saveSpaceForT<std::uint64_t>();
-        const auto wordsCountsBitsCntPos = dataConstructor.saveSpaceForT<std::uint64_t>();
-        dataConstructor.putT<std::uint64_t>(ordFlow.size());
-        const auto contentBitsCntPos = dataConstructor.saveSpaceForT<std::uint64_t>();
-
-        auto countsMapping = ael::NumericalCoder::countWords(ordFlow); 
-
-        auto wordsProgressBar = indicators::ProgressBar(
-            indicators::option::BarWidth{50},
-            indicators::option::MaxProgress{countsMapping.size()},
-            indicators::option::ShowPercentage{true},
-            indicators::option::PostfixText{"Encoding words"},
-            indicators::option::Stream{outStream}
-        );
-        auto countsProgressBar = indicators::ProgressBar(
-            indicators::option::BarWidth{50},
-            indicators::option::MaxProgress{countsMapping.size()},
-            indicators::option::ShowPercentage{true},
-            indicators::option::PostfixText{"Encoding counts"},
-            indicators::option::Stream{outStream}
-        );
-        auto contentProgressBar = indicators::ProgressBar(
-            indicators::option::BarWidth{50},
-            indicators::option::MaxProgress{ordFlow.size()},
-            indicators::option::ShowPercentage{true},
-            indicators::option::PostfixText{"Encoding content"},
-            indicators::option::Stream{outStream}
-        );
-
-        auto layoutInfo =
-            ael::NumericalCoder::encode(
-                ordFlow, countsMapping, dataConstructor, 
-                [&wordsProgressBar]{ wordsProgressBar.tick(); },
-                [&countsProgressBar]{ countsProgressBar.tick(); },
-                [&contentProgressBar]{ contentProgressBar.tick(); }
-            );
-
-        dataConstructor.putTToPosition(layoutInfo.dictSize,
-                                       dictSizePos);
-        dataConstructor.putTToPosition(layoutInfo.wordsBitsCnt,
-                                       wordsBitsCntPos);                               
-        dataConstructor.putTToPosition(layoutInfo.wordsCountsBitsCnt,
-                                       wordsCountsBitsCntPos);
-        dataConstructor.putTToPosition(layoutInfo.contentBitsCnt,
-                                       contentBitsCntPos);
-
-        fileOpener.getOutFileStream().write(dataConstructor.data<char>(),
-                                            dataConstructor.size());
-
+        const auto jobs = BatchImpl::makeJobs(batchOptions, "-encoded");
+        BatchImpl::run(jobs, batchOptions, outStream,
+                       [&](const BatchImpl::Job& job,
+                           std::ostream& logStream,
+                           Stats& stats) {
+            auto fileOpener = FileOpener(job.inFileName, job.outFileName,
+                                         logStream, stats);
+            auto inFileBytes = fileOpener.getInData();
+
+            // Words are single bytes, so BytesUnpacker would only copy the
+            // input to an ords buffer as large as it. Ords are read from the
+            // input as the coder goes instead.
+            const auto ordFlow = inFileBytes
+                | std::views::transform([](std::byte byte) {
+                      return std::to_integer<std::uint64_t>(byte);
+                  });
+            stats.addWords(ordFlow.size());
+            stats.setBitsPerWord(8);
+
+            auto dataConstructor = ael::ByteDataConstructor();        
+
+            const auto dictSizePos = dataConstructor.saveSpaceForT<std::uint64_t>();
+            const auto wordsBitsCntPos = dataConstructor.saveSpaceForT<std::uint64_t>();
+            const auto wordsCountsBitsCntPos = dataConstructor.saveSpaceForT<std::uint64_t>();
+            dataConstructor.putT<std::uint64_t>(ordFlow.size());
+            const auto contentBitsCntPos = dataConstructor.saveSpaceForT<std::uint64_t>();
+
+            auto countsMapping = ael::NumericalCoder::countWords(ordFlow); 
+
+            auto wordsProgress = ProgressMeter(
+                logStream, "Encoding words", countsMapping.size(), 0);
+            auto countsProgress = ProgressMeter(
+                logStream, "Encoding counts", countsMapping.size(), 0);
+            auto contentProgress = ProgressMeter(
+                logStream, "Encoding content", ordFlow.size(), 1);
+
+            auto layoutInfo = [&] {
+                auto timer = stats.time(Stats::Phase::Code);
+                return ael::NumericalCoder::encode(
+                    ordFlow, countsMapping, dataConstructor, 
+                    wordsProgress.getTick(),
+                    countsProgress.getTick(),
+                    contentProgress.getTick()
+                );
+            }();
+            wordsProgress.finish();
+            countsProgress.finish();
+            contentProgress.finish();
+
+            dataConstructor.putTToPosition(layoutInfo.dictSize,
+                                           dictSizePos);
+            dataConstructor.putTToPosition(layoutInfo.wordsBitsCnt,
+                                           wordsBitsCntPos);                               
+            dataConstructor.putTToPosition(layoutInfo.wordsCountsBitsCnt,
+                                           wordsCountsBitsCntPos);
+            dataConstructor.putTToPosition(layoutInfo.contentBitsCnt,
+                                           contentBitsCntPos);
+
+            auto timer = stats.time(Stats::Phase::Write);
+            fileOpener.getOutFileStream().write(dataConstructor.data<char>(),
+                                                dataConstructor.size());
+            stats.addBytesOut(dataConstructor.size());
+        });
     } catch (const std::runtime_error& error) {
         std::cerr << error.what() << std::endl;
         return 1;
@@ -0,0 +1,8 @@
+#include <applib/rans_coder.hpp>
+#include <applib/semi_static_impl.hpp>
+
+//----------------------------------------------------------------------------//
+int main(int argc, char* argv[]) {
+    return SemiStaticImpl::encode<RansCoder>(argc, argv,
+                                             FramesLayout::Coder::Rans);
+}